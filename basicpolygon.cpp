@@ -0,0 +1,144 @@
+#include "basicpolygon.h"
+#include "instrumentation.h"
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+static void checkVertexCount(size_t count) {
+    if (count < 3) {
+        throw std::invalid_argument(
+            "Многоугольник должен иметь минимум 3 вершины. Передано: " +
+            std::to_string(count)
+            );
+    }
+}
+
+template <typename T>
+BasicPolygon<T>::BasicPolygon(const std::vector<QPointF> &verts)
+    : Shape(0.0, 0.0)
+{
+    checkVertexCount(verts.size());
+
+    // Опорная точка — центр масс, посчитанный в double: локальные
+    // координаты малы, и округление до T их почти не портит
+    anchor = polygonCentroid(verts.data(), verts.size());
+    points.reserve(verts.size());
+    for (const QPointF &v : verts) {
+        points.push_back(Point2<T>{static_cast<T>(v.x() - anchor.x()), static_cast<T>(v.y() - anchor.y())});
+    }
+
+    const Point2<T> center = polygonCentroid(points.data(), points.size());
+    centerX = anchor.x() + center.x;
+    centerY = anchor.y() + center.y;
+}
+
+template <typename T>
+BasicPolygon<T>::BasicPolygon(std::vector<Point2<T>> local, const QPointF &origin)
+    : Shape(0.0, 0.0), points(std::move(local)), anchor(origin)
+{
+    checkVertexCount(points.size());
+
+    const Point2<T> center = polygonCentroid(points.data(), points.size());
+    centerX = anchor.x() + center.x;
+    centerY = anchor.y() + center.y;
+}
+
+template <typename T>
+QPointF BasicPolygon<T>::toScene(const Point2<T> &point) const {
+    return QPointF(anchor.x() + point.x, anchor.y() + point.y);
+}
+
+template <typename T>
+double BasicPolygon<T>::area() const {
+    SHAPE_PROBE_SHAPE(Area);
+    return polygonArea(points.data(), points.size());
+}
+
+template <typename T>
+double BasicPolygon<T>::perimeter() const {
+    SHAPE_PROBE_SHAPE(Perimeter);
+    return polygonPerimeter(points.data(), points.size());
+}
+
+template <typename T>
+void BasicPolygon<T>::move(double dx, double dy) {
+    SHAPE_PROBE_SHAPE(Move);
+
+    centerX += dx;
+    centerY += dy;
+    anchor += QPointF(dx, dy);
+}
+
+// Поворот и масштаб вокруг (originX, originY): опорная точка и центр
+// преобразуются в double, локальные вершины — вокруг нуля в T
+template <typename T>
+void BasicPolygon<T>::rotate(double angleDeg, double originX, double originY) {
+    SHAPE_PROBE_SHAPE(Rotate);
+
+    const QPointF newCenter = rotatePoint(QPointF(centerX, centerY), angleDeg, originX, originY);
+    centerX = newCenter.x();
+    centerY = newCenter.y();
+    anchor = rotatePoint(anchor, angleDeg, originX, originY);
+
+    rotatePoints(points.data(), points.size(), static_cast<T>(angleDeg), T(0), T(0));
+}
+
+template <typename T>
+void BasicPolygon<T>::scale(double factor, double originX, double originY) {
+    SHAPE_PROBE_SHAPE(Scale);
+    if (factor <= 0.0) {
+        throw std::invalid_argument(
+            "Коэффициент масштабирования должен быть положительным. "
+            "Передано: " + std::to_string(factor)
+            );
+    }
+
+    const QPointF newCenter = scalePoint(QPointF(centerX, centerY), factor, originX, originY);
+    centerX = newCenter.x();
+    centerY = newCenter.y();
+    anchor = scalePoint(anchor, factor, originX, originY);
+
+    scalePoints(points.data(), points.size(), static_cast<T>(factor), T(0), T(0));
+}
+
+template <typename T>
+void BasicPolygon<T>::draw(QPainter &painter) const {
+    SHAPE_PROBE_SHAPE(Draw);
+
+    QPolygonF polygon;
+    for (const Point2<T> &p : points) {
+        polygon << toScene(p);
+    }
+    drawPolygonShape(painter, polygon, QPointF(centerX, centerY));
+}
+
+template <typename T>
+QRectF BasicPolygon<T>::boundingRect() const {
+    T minX = points[0].x;
+    T maxX = minX;
+    T minY = points[0].y;
+    T maxY = minY;
+
+    for (const Point2<T> &p : points) {
+        minX = std::min(minX, p.x);
+        maxX = std::max(maxX, p.x);
+        minY = std::min(minY, p.y);
+        maxY = std::max(maxY, p.y);
+    }
+
+    return QRectF(anchor.x() + minX, anchor.y() + minY,
+                  static_cast<double>(maxX) - minX, static_cast<double>(maxY) - minY);
+}
+
+template <typename T>
+std::vector<QPointF> BasicPolygon<T>::outline() const {
+    std::vector<QPointF> result;
+    result.reserve(points.size());
+    for (const Point2<T> &p : points) {
+        result.push_back(toScene(p));
+    }
+    return result;
+}
+
+template class BasicPolygon<float>;
+template class BasicPolygon<double>;
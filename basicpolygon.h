@@ -0,0 +1,53 @@
+#ifndef BASICPOLYGON_H
+#define BASICPOLYGON_H
+
+#include "geometrycore.h"
+#include "shape.h"
+#include <vector>
+
+// Многоугольник с вершинами типа Point2<T>. Площадь, периметр, поворот
+// и масштаб считаются ядром geometrycore прямо над хранимыми вершинами,
+// без промежуточного контура в double: у BasicPolygon<float> вершина
+// занимает 8 байт вместо 16 у QPointF, и пакетные преобразования
+// гоняют через память вдвое меньше данных.
+//
+// Вершины хранятся относительно опорной точки anchor (в double):
+// float не теряет точность вдали от начала координат, а сдвиг меняет
+// только anchor. В QPointF вершины переводятся лишь для отрисовки,
+// outline() и расстояний. Явно инстанцирован для float и double.
+template <typename T>
+class BasicPolygon : public Shape {
+private:
+    std::vector<Point2<T>> points;
+    QPointF anchor;
+
+    QPointF toScene(const Point2<T> &point) const;
+
+public:
+    explicit BasicPolygon(const std::vector<QPointF> &verts);
+
+    // Вершины local относительно точки origin
+    BasicPolygon(std::vector<Point2<T>> local, const QPointF &origin);
+
+    double area() const override;
+    double perimeter() const override;
+    void move(double dx, double dy) override;
+    void rotate(double angleDeg, double originX, double originY) override;
+    void scale(double factor, double originX, double originY) override;
+    void draw(QPainter &painter) const override;
+    QRectF boundingRect() const override;
+    std::vector<QPointF> outline() const override;
+    std::unique_ptr<Shape> clone() const override { return std::make_unique<BasicPolygon>(*this); }
+
+    size_t vertexCount() const { return points.size(); }
+    const std::vector<Point2<T>> &localVertices() const { return points; }
+    const QPointF &origin() const { return anchor; }
+};
+
+using FloatPolygon = BasicPolygon<float>;
+using DoublePolygon = BasicPolygon<double>;
+
+extern template class BasicPolygon<float>;
+extern template class BasicPolygon<double>;
+
+#endif // BASICPOLYGON_H
@@ -0,0 +1,349 @@
+#include "batchexporter.h"
+#include "circle.h"
+#include "hexagon.h"
+#include "parallel.h"
+#include "parametricshape.h"
+#include "rectangle.h"
+#include "rhombus.h"
+#include "softwarerasterizer.h"
+#include "square.h"
+#include "star.h"
+#include "triangulation.h"
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+
+namespace {
+
+enum PrototypeKind {
+    CirclePrototype,
+    StarPrototype,
+    HexagonPrototype,
+    BoxPrototype,
+    RhombusPrototype,
+    UniqueMesh
+};
+
+const int kCircleSegments = 64;
+
+// Счётчики в заголовке и диапазонах 32-битные; итоги считаются в size_t
+// и проверяются, чтобы переполнение не дало битый пакет
+void checkTotal(size_t total, const char *what) {
+    const size_t limit = std::numeric_limits<uint32_t>::max();
+    if (total > limit) {
+        throw std::invalid_argument(
+            std::string("Слишком много ") + what + " для пакета: " +
+            std::to_string(total) + ", максимум: " + std::to_string(limit)
+            );
+    }
+}
+
+struct ShapeEntry {
+    int kind = UniqueMesh;
+    int points = 0;
+    double parameter = 0.0;
+
+    // Преобразование единичной сетки в мировые координаты
+    double m11 = 1.0, m12 = 0.0, m21 = 0.0, m22 = 1.0, dx = 0.0, dy = 0.0;
+    uint8_t rgba[4] = {0, 0, 0, 0};
+
+    std::vector<QPointF> outline;
+    std::vector<uint32_t> triangles;
+
+    std::tuple<int, int, long long> key() const {
+        return std::make_tuple(kind, points, std::llround(parameter * 1e9));
+    }
+
+    void setPose(double angleDeg, double sx, double sy, double cx, double cy) {
+        double angleRad = angleDeg * M_PI / 180.0;
+        double c = std::cos(angleRad);
+        double s = std::sin(angleRad);
+        m11 = c * sx;
+        m12 = s * sx;
+        m21 = -s * sy;
+        m22 = c * sy;
+        dx = cx;
+        dy = cy;
+    }
+};
+
+double directionDeg(const QPointF &from, const QPointF &to) {
+    return std::atan2(to.y() - from.y(), to.x() - from.x()) * 180.0 / M_PI;
+}
+
+ShapeEntry describe(const Shape &shape) {
+    ShapeEntry entry;
+
+    QColor color = SoftwareRasterizer::defaultFillColor(shape);
+    entry.rgba[0] = static_cast<uint8_t>(color.red());
+    entry.rgba[1] = static_cast<uint8_t>(color.green());
+    entry.rgba[2] = static_cast<uint8_t>(color.blue());
+    entry.rgba[3] = static_cast<uint8_t>(color.alpha());
+
+    const double cx = shape.getCenterX();
+    const double cy = shape.getCenterY();
+
+    if (const Circle *circle = dynamic_cast<const Circle*>(&shape)) {
+        entry.kind = CirclePrototype;
+        entry.setPose(0.0, circle->getRadius(), circle->getRadius(), cx, cy);
+        return entry;
+    }
+
+    if (const ParametricShape *compact = dynamic_cast<const ParametricShape*>(&shape)) {
+        double size = compact->getSize();
+        switch (compact->getKind()) {
+        case ParametricShape::StarKind:
+            entry.kind = StarPrototype;
+            entry.points = compact->getPointsCount();
+            entry.parameter = compact->getParameter();
+            break;
+        case ParametricShape::HexagonKind:
+            entry.kind = HexagonPrototype;
+            break;
+        case ParametricShape::SquareKind:
+            entry.kind = BoxPrototype;
+            break;
+        case ParametricShape::RhombusKind:
+            entry.kind = RhombusPrototype;
+            entry.parameter = compact->getParameter();
+            break;
+        }
+        entry.setPose(compact->getRotation(), size, size, cx, cy);
+        return entry;
+    }
+
+    // Вершины читаются копией outline(): describe() вызывается из
+    // нескольких потоков и не должна трогать буфер вершин фигуры
+    if (const Star *star = dynamic_cast<const Star*>(&shape)) {
+        const std::vector<QPointF> verts = star->outline();
+        if (verts.size() == static_cast<size_t>(2 * star->getPointsCount())) {
+            QPointF center(cx, cy);
+            double outer = distanceBetweenPoints(center, verts[0]);
+            double inner = distanceBetweenPoints(center, verts[1]);
+            entry.kind = StarPrototype;
+            entry.points = star->getPointsCount();
+            entry.parameter = inner / outer;
+            entry.setPose(directionDeg(center, verts[0]) + 90.0, outer, outer, cx, cy);
+            return entry;
+        }
+    }
+
+    if (const Hexagon *hexagon = dynamic_cast<const Hexagon*>(&shape)) {
+        entry.kind = HexagonPrototype;
+        entry.setPose(hexagon->getOrientation(), hexagon->getSide(), hexagon->getSide(), cx, cy);
+        return entry;
+    }
+
+    if (const Square *square = dynamic_cast<const Square*>(&shape)) {
+        entry.kind = BoxPrototype;
+        entry.setPose(square->getOrientation(), square->getSide(), square->getSide(), cx, cy);
+        return entry;
+    }
+
+    if (const Rectangle *rectangle = dynamic_cast<const Rectangle*>(&shape)) {
+        entry.kind = BoxPrototype;
+        entry.setPose(rectangle->getOrientation(), rectangle->getWidth(), rectangle->getHeight(), cx, cy);
+        return entry;
+    }
+
+    if (const Rhombus *rhombus = dynamic_cast<const Rhombus*>(&shape)) {
+        const std::vector<QPointF> verts = rhombus->outline();
+        entry.kind = RhombusPrototype;
+        entry.parameter = rhombus->getAcuteAngle();
+        entry.setPose(directionDeg(verts[0], verts[2]),
+                      rhombus->getSide(), rhombus->getSide(), cx, cy);
+        return entry;
+    }
+
+    entry.kind = UniqueMesh;
+    entry.outline = shape.outline();
+    entry.triangles = triangulatePolygon(entry.outline);
+    return entry;
+}
+
+// Сетка прототипа в единичных размерах
+void buildPrototype(const ShapeEntry &entry, std::vector<QPointF> &verts, std::vector<uint32_t> &triangles) {
+    verts.clear();
+
+    switch (entry.kind) {
+    case CirclePrototype:
+        verts.emplace_back(0.0, 0.0);
+        for (int i = 0; i < kCircleSegments; ++i) {
+            double angle = 2.0 * M_PI * i / kCircleSegments;
+            verts.emplace_back(std::cos(angle), std::sin(angle));
+        }
+        triangles = triangulateFan(0, 1, kCircleSegments);
+        break;
+    case StarPrototype:
+        verts.emplace_back(0.0, 0.0);
+        for (int i = 0; i < 2 * entry.points; ++i) {
+            double angle = -M_PI_2 + i * M_PI / entry.points;
+            double radius = (i % 2 == 0) ? 1.0 : entry.parameter;
+            verts.emplace_back(radius * std::cos(angle), radius * std::sin(angle));
+        }
+        triangles = triangulateFan(0, 1, static_cast<uint32_t>(2 * entry.points));
+        break;
+    case HexagonPrototype:
+        verts.emplace_back(0.0, 0.0);
+        for (int i = 0; i < 6; ++i) {
+            double angle = -i * M_PI / 3.0;
+            verts.emplace_back(std::cos(angle), std::sin(angle));
+        }
+        triangles = triangulateFan(0, 1, 6);
+        break;
+    case BoxPrototype:
+        verts = { QPointF(-0.5, -0.5), QPointF(0.5, -0.5), QPointF(0.5, 0.5), QPointF(-0.5, 0.5) };
+        triangles = { 0, 1, 2, 0, 2, 3 };
+        break;
+    case RhombusPrototype: {
+        double halfAngle = entry.parameter * M_PI / 360.0;
+        double hx = std::cos(halfAngle);
+        double hy = std::sin(halfAngle);
+        verts = { QPointF(-hx, 0.0), QPointF(0.0, -hy), QPointF(hx, 0.0), QPointF(0.0, hy) };
+        triangles = { 0, 1, 2, 0, 2, 3 };
+        break;
+    }
+    default:
+        verts = entry.outline;
+        triangles = entry.triangles;
+        break;
+    }
+}
+
+size_t alignUp(size_t value) {
+    return (value + 7) & ~static_cast<size_t>(7);
+}
+
+} // namespace
+
+const BatchHeader &ExportBatch::header() const {
+    return *reinterpret_cast<const BatchHeader*>(storage.get());
+}
+
+const MeshRange *ExportBatch::meshes() const {
+    return reinterpret_cast<const MeshRange*>(storage.get() + header().meshesOffset);
+}
+
+const float *ExportBatch::positions() const {
+    return reinterpret_cast<const float*>(storage.get() + header().positionsOffset);
+}
+
+const uint32_t *ExportBatch::indices() const {
+    return reinterpret_cast<const uint32_t*>(storage.get() + header().indicesOffset);
+}
+
+const InstanceRecord *ExportBatch::instances() const {
+    return reinterpret_cast<const InstanceRecord*>(storage.get() + header().instancesOffset);
+}
+
+ExportBatch exportScene(const std::vector<const Shape*> &shapes) {
+    std::vector<ShapeEntry> entries(shapes.size());
+    parallelFor(shapes.size(), [&](size_t i) {
+        entries[i] = describe(*shapes[i]);
+    });
+
+    // Группы: один прототип на ключ, у уникальных сеток — своя группа
+    std::map<std::tuple<int, int, long long>, uint32_t> prototypeGroups;
+    std::vector<size_t> groupSource;
+    std::vector<uint32_t> groupOfEntry(entries.size());
+
+    for (size_t i = 0; i < entries.size(); ++i) {
+        if (entries[i].kind == UniqueMesh) {
+            groupOfEntry[i] = static_cast<uint32_t>(groupSource.size());
+            groupSource.push_back(i);
+            continue;
+        }
+
+        auto inserted = prototypeGroups.emplace(entries[i].key(), static_cast<uint32_t>(groupSource.size()));
+        if (inserted.second) {
+            groupSource.push_back(i);
+        }
+        groupOfEntry[i] = inserted.first->second;
+    }
+
+    const size_t groupCount = groupSource.size();
+    std::vector<MeshRange> ranges(groupCount);
+    std::vector<QPointF> verts;
+    std::vector<uint32_t> triangles;
+
+    size_t vertexTotal = 0;
+    size_t indexTotal = 0;
+    for (size_t g = 0; g < groupCount; ++g) {
+        buildPrototype(entries[groupSource[g]], verts, triangles);
+        ranges[g].firstVertex = static_cast<uint32_t>(vertexTotal);
+        ranges[g].vertexCount = static_cast<uint32_t>(verts.size());
+        ranges[g].firstIndex = static_cast<uint32_t>(indexTotal);
+        ranges[g].indexCount = static_cast<uint32_t>(triangles.size());
+        ranges[g].instanceCount = 0;
+        vertexTotal += verts.size();
+        indexTotal += triangles.size();
+        checkTotal(vertexTotal, "вершин");
+        checkTotal(indexTotal, "индексов");
+    }
+
+    for (uint32_t group : groupOfEntry) {
+        ++ranges[group].instanceCount;
+    }
+    uint32_t instanceTotal = 0;
+    for (MeshRange &range : ranges) {
+        range.firstInstance = instanceTotal;
+        instanceTotal += range.instanceCount;
+    }
+
+    BatchHeader header;
+    header.magic = ExportBatch::kMagic;
+    header.version = ExportBatch::kVersion;
+    header.meshCount = static_cast<uint32_t>(groupCount);
+    header.vertexCount = static_cast<uint32_t>(vertexTotal);
+    header.indexCount = static_cast<uint32_t>(indexTotal);
+    header.instanceCount = instanceTotal;
+    header.meshesOffset = alignUp(sizeof(BatchHeader));
+    header.positionsOffset = alignUp(header.meshesOffset + groupCount * sizeof(MeshRange));
+    header.indicesOffset = alignUp(header.positionsOffset + 2 * sizeof(float) * vertexTotal);
+    header.instancesOffset = alignUp(header.indicesOffset + sizeof(uint32_t) * indexTotal);
+
+    ExportBatch batch;
+    batch.byteSize = header.instancesOffset + sizeof(InstanceRecord) * static_cast<size_t>(instanceTotal);
+    batch.storage.reset(new unsigned char[batch.byteSize]());
+
+    unsigned char *base = batch.storage.get();
+    std::memcpy(base, &header, sizeof(header));
+    std::memcpy(base + header.meshesOffset, ranges.data(), groupCount * sizeof(MeshRange));
+
+    float *positions = reinterpret_cast<float*>(base + header.positionsOffset);
+    uint32_t *indices = reinterpret_cast<uint32_t*>(base + header.indicesOffset);
+    for (size_t g = 0; g < groupCount; ++g) {
+        buildPrototype(entries[groupSource[g]], verts, triangles);
+
+        float *p = positions + 2 * static_cast<size_t>(ranges[g].firstVertex);
+        for (const QPointF &v : verts) {
+            *p++ = static_cast<float>(v.x());
+            *p++ = static_cast<float>(v.y());
+        }
+        std::memcpy(indices + ranges[g].firstIndex, triangles.data(), triangles.size() * sizeof(uint32_t));
+    }
+
+    InstanceRecord *instances = reinterpret_cast<InstanceRecord*>(base + header.instancesOffset);
+    std::vector<uint32_t> cursor(groupCount);
+    for (size_t g = 0; g < groupCount; ++g) {
+        cursor[g] = ranges[g].firstInstance;
+    }
+
+    for (size_t i = 0; i < entries.size(); ++i) {
+        const ShapeEntry &entry = entries[i];
+        InstanceRecord &record = instances[cursor[groupOfEntry[i]]++];
+        record.m11 = static_cast<float>(entry.m11);
+        record.m12 = static_cast<float>(entry.m12);
+        record.m21 = static_cast<float>(entry.m21);
+        record.m22 = static_cast<float>(entry.m22);
+        record.dx = static_cast<float>(entry.dx);
+        record.dy = static_cast<float>(entry.dy);
+        std::memcpy(record.rgba, entry.rgba, sizeof(record.rgba));
+    }
+
+    return batch;
+}
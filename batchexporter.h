@@ -0,0 +1,72 @@
+#ifndef BATCHEXPORTER_H
+#define BATCHEXPORTER_H
+
+#include "shape.h"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Экспорт сцены в плоские буферы для внешнего рендерера.
+// Одинаковые параметрические фигуры (окружности, звёзды, шестиугольники,
+// квадраты, прямоугольники, ромбы) используют одну сетку в единичных
+// размерах и различаются только записями экземпляров. Остальные фигуры
+// получают собственную сетку в мировых координатах.
+//
+// Всё лежит в одном непрерывном блоке памяти:
+// [BatchHeader][MeshRange × meshCount][float x,y × vertexCount]
+// [uint32 × indexCount][InstanceRecord × instanceCount]
+struct BatchHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t meshCount;
+    uint32_t vertexCount;
+    uint32_t indexCount;
+    uint32_t instanceCount;
+    uint64_t meshesOffset;
+    uint64_t positionsOffset;
+    uint64_t indicesOffset;
+    uint64_t instancesOffset;
+};
+
+struct MeshRange {
+    uint32_t firstVertex;
+    uint32_t vertexCount;
+    uint32_t firstIndex;
+    uint32_t indexCount;
+    uint32_t firstInstance;
+    uint32_t instanceCount;
+};
+
+// Аффинное преобразование в порядке QTransform:
+// x' = m11 * x + m21 * y + dx,  y' = m12 * x + m22 * y + dy
+struct InstanceRecord {
+    float m11, m12, m21, m22, dx, dy;
+    uint8_t rgba[4];
+};
+
+class ExportBatch {
+private:
+    std::unique_ptr<unsigned char[]> storage;
+    size_t byteSize = 0;
+
+    friend ExportBatch exportScene(const std::vector<const Shape*> &shapes);
+
+public:
+    static const uint32_t kMagic = 0x48535442; // "BTSH"
+    static const uint32_t kVersion = 1;
+
+    const unsigned char *data() const { return storage.get(); }
+    size_t size() const { return byteSize; }
+
+    const BatchHeader &header() const;
+    const MeshRange *meshes() const;
+    const float *positions() const;
+    const uint32_t *indices() const;
+    const InstanceRecord *instances() const;
+};
+
+// Бросает std::invalid_argument, если вершин или индексов больше,
+// чем помещается в 32-битные счётчики заголовка
+ExportBatch exportScene(const std::vector<const Shape*> &shapes);
+
+#endif // BATCHEXPORTER_H
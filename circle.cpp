@@ -1,4 +1,5 @@
 #include "circle.h"
+#include "instrumentation.h"
 #include <cmath>
 #include <stdexcept>
 #ifndef M_PI
@@ -17,25 +18,30 @@ Circle::Circle(double x, double y, double r)
 }
 
 double Circle::area() const {
+    SHAPE_PROBE_SHAPE(Area);
     return M_PI * radius * radius;
 }
 
 double Circle::perimeter() const {
+    SHAPE_PROBE_SHAPE(Perimeter);
     return 2.0 * M_PI * radius;
 }
 
 void Circle::move(double dx, double dy) {
+    SHAPE_PROBE_SHAPE(Move);
     centerX += dx;
     centerY += dy;
 }
 
 void Circle::rotate(double angleDeg, double originX, double originY) {
+    SHAPE_PROBE_SHAPE(Rotate);
     QPointF newCenter = rotatePoint(QPointF(centerX, centerY), angleDeg, originX, originY);
     centerX = newCenter.x();
     centerY = newCenter.y();
 }
 
 void Circle::scale(double factor, double originX, double originY) {
+    SHAPE_PROBE_SHAPE(Scale);
     if (factor <= 0.0) {
         throw std::invalid_argument(
             "Коэффициент масштабирования должен быть положительным. "
@@ -51,6 +57,7 @@ void Circle::scale(double factor, double originX, double originY) {
 }
 
 void Circle::draw(QPainter &painter) const {
+    SHAPE_PROBE_SHAPE(Draw);
     painter.setRenderHint(QPainter::Antialiasing, true);
 
     painter.setPen(QPen(Qt::blue, 2));
@@ -61,6 +68,32 @@ void Circle::draw(QPainter &painter) const {
     painter.drawPoint(QPointF(centerX, centerY));
 }
 
+QRectF Circle::boundingRect() const {
+    return QRectF(centerX - radius, centerY - radius, 2.0 * radius, 2.0 * radius);
+}
+
+std::vector<QPointF> Circle::outline() const {
+    const int segments = 64;
+
+    std::vector<QPointF> points;
+    points.reserve(segments);
+
+    for (int i = 0; i < segments; ++i) {
+        double angle = 2.0 * M_PI * i / segments;
+        points.emplace_back(centerX + radius * std::cos(angle), centerY + radius * std::sin(angle));
+    }
+
+    return points;
+}
+
+void Circle::signedDistances(const double *xs, const double *ys, double *out, size_t count) const {
+    for (size_t i = 0; i < count; ++i) {
+        double dx = xs[i] - centerX;
+        double dy = ys[i] - centerY;
+        out[i] = std::sqrt(dx * dx + dy * dy) - radius;
+    }
+}
+
 void Circle::setRadius(double r) {
     if (r <= 0.0) {
         throw std::invalid_argument(
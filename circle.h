@@ -18,6 +18,10 @@ public:
     void rotate(double angleDeg, double originX, double originY) override;
     void scale(double factor, double originX, double originY) override;
     void draw(QPainter &painter) const override;
+    QRectF boundingRect() const override;
+    std::vector<QPointF> outline() const override;
+    void signedDistances(const double *xs, const double *ys, double *out, size_t count) const override;
+    std::unique_ptr<Shape> clone() const override { return std::make_unique<Circle>(*this); }
 
 
     void setRadius(double r);
@@ -0,0 +1,269 @@
+#include "commandjournal.h"
+#include "circle.h"
+#include "heart.h"
+#include "hexagon.h"
+#include "polygon.h"
+#include "rectangle.h"
+#include "rhombus.h"
+#include "square.h"
+#include <string>
+
+template <typename T>
+static T &shapeAs(Shape &shape, const char *command) {
+    T *typed = dynamic_cast<T*>(&shape);
+    if (!typed) {
+        throw std::invalid_argument(
+            std::string("Команда ") + command + " не применима к этой фигуре"
+            );
+    }
+    return *typed;
+}
+
+template <typename T>
+static const T &shapeAs(const Shape &shape, const char *command) {
+    return shapeAs<T>(const_cast<Shape&>(shape), command);
+}
+
+static ShapeCommand makeCommand(ShapeCommand::Type type, size_t shape, double a, double b = 0.0, double c = 0.0) {
+    ShapeCommand command;
+    command.type = type;
+    command.shapeIndex = shape;
+    command.a = a;
+    command.b = b;
+    command.c = c;
+    return command;
+}
+
+ShapeCommand ShapeCommand::move(size_t shape, double dx, double dy) {
+    return makeCommand(Move, shape, dx, dy);
+}
+
+ShapeCommand ShapeCommand::rotate(size_t shape, double angleDeg, double originX, double originY) {
+    return makeCommand(Rotate, shape, angleDeg, originX, originY);
+}
+
+ShapeCommand ShapeCommand::scale(size_t shape, double factor, double originX, double originY) {
+    if (factor <= 0.0) {
+        throw std::invalid_argument(
+            "Коэффициент масштабирования должен быть положительным. Передано: " +
+            std::to_string(factor)
+            );
+    }
+    return makeCommand(Scale, shape, factor, originX, originY);
+}
+
+ShapeCommand ShapeCommand::setVertex(size_t shape, size_t vertex, const QPointF &point) {
+    ShapeCommand command = makeCommand(SetVertex, shape, point.x(), point.y());
+    command.vertexIndex = static_cast<uint32_t>(vertex);
+    return command;
+}
+
+ShapeCommand ShapeCommand::setRadius(size_t shape, double radius) {
+    return makeCommand(SetRadius, shape, radius);
+}
+
+ShapeCommand ShapeCommand::setSide(size_t shape, double side) {
+    return makeCommand(SetSide, shape, side);
+}
+
+ShapeCommand ShapeCommand::setWidth(size_t shape, double width) {
+    return makeCommand(SetWidth, shape, width);
+}
+
+ShapeCommand ShapeCommand::setHeight(size_t shape, double height) {
+    return makeCommand(SetHeight, shape, height);
+}
+
+ShapeCommand ShapeCommand::setAcuteAngle(size_t shape, double angle) {
+    return makeCommand(SetAcuteAngle, shape, angle);
+}
+
+ShapeCommand ShapeCommand::setSize(size_t shape, double size) {
+    return makeCommand(SetSize, shape, size);
+}
+
+ShapeCommand ShapeCommand::setResolution(size_t shape, int resolution) {
+    return makeCommand(SetResolution, shape, resolution);
+}
+
+static double sideOf(const Shape &shape) {
+    if (const Square *square = dynamic_cast<const Square*>(&shape)) return square->getSide();
+    if (const Hexagon *hexagon = dynamic_cast<const Hexagon*>(&shape)) return hexagon->getSide();
+    return shapeAs<Rhombus>(shape, "setSide").getSide();
+}
+
+static void setSideOf(Shape &shape, double side) {
+    if (Square *square = dynamic_cast<Square*>(&shape)) {
+        square->setSide(side);
+    } else if (Hexagon *hexagon = dynamic_cast<Hexagon*>(&shape)) {
+        hexagon->setSide(side);
+    } else {
+        shapeAs<Rhombus>(shape, "setSide").setSide(side);
+    }
+}
+
+void ShapeCommand::captureState(const Shape &shape) {
+    switch (type) {
+    case Move:
+    case Rotate:
+    case Scale:
+        break;
+    case SetVertex: {
+        const Polygon &polygon = shapeAs<Polygon>(shape, "setVertex");
+        const QPointF point = polygon.vertex(vertexIndex);
+        oldA = point.x();
+        oldB = point.y();
+        break;
+    }
+    case SetRadius:
+        oldA = shapeAs<Circle>(shape, "setRadius").getRadius();
+        break;
+    case SetSide:
+        oldA = sideOf(shape);
+        break;
+    case SetWidth:
+        oldA = shapeAs<Rectangle>(shape, "setWidth").getWidth();
+        break;
+    case SetHeight:
+        oldA = shapeAs<Rectangle>(shape, "setHeight").getHeight();
+        break;
+    case SetAcuteAngle:
+        oldA = shapeAs<Rhombus>(shape, "setAcuteAngle").getAcuteAngle();
+        previous = shapeAs<Rhombus>(shape, "setAcuteAngle").clone();
+        break;
+    case SetSize:
+        oldA = shapeAs<Heart>(shape, "setSize").getSize();
+        break;
+    case SetResolution:
+        oldA = shapeAs<Heart>(shape, "setResolution").getResolution();
+        previous = shapeAs<Heart>(shape, "setResolution").clone();
+        break;
+    }
+}
+
+// Применяет команду со значением value (новым или прежним)
+static void assign(ShapeCommand::Type type, Shape &shape, uint32_t vertex, double value, double second) {
+    switch (type) {
+    case ShapeCommand::SetVertex:
+        shapeAs<Polygon>(shape, "setVertex").setVertex(vertex, QPointF(value, second));
+        break;
+    case ShapeCommand::SetRadius:
+        shapeAs<Circle>(shape, "setRadius").setRadius(value);
+        break;
+    case ShapeCommand::SetSide:
+        setSideOf(shape, value);
+        break;
+    case ShapeCommand::SetWidth:
+        shapeAs<Rectangle>(shape, "setWidth").setWidth(value);
+        break;
+    case ShapeCommand::SetHeight:
+        shapeAs<Rectangle>(shape, "setHeight").setHeight(value);
+        break;
+    case ShapeCommand::SetAcuteAngle:
+        shapeAs<Rhombus>(shape, "setAcuteAngle").setAcuteAngle(value);
+        break;
+    case ShapeCommand::SetSize:
+        shapeAs<Heart>(shape, "setSize").setSize(value);
+        break;
+    case ShapeCommand::SetResolution:
+        shapeAs<Heart>(shape, "setResolution").setResolution(static_cast<int>(value));
+        break;
+    default:
+        break;
+    }
+}
+
+void ShapeCommand::apply(Shape &shape) const {
+    switch (type) {
+    case Move:
+        shape.move(a, b);
+        break;
+    case Rotate:
+        shape.rotate(a, b, c);
+        break;
+    case Scale:
+        shape.scale(a, b, c);
+        break;
+    default:
+        assign(type, shape, vertexIndex, a, b);
+        break;
+    }
+}
+
+void ShapeCommand::revert(Shape &shape) const {
+    switch (type) {
+    case Move:
+        shape.move(-a, -b);
+        break;
+    case Rotate:
+        shape.rotate(-a, b, c);
+        break;
+    case Scale:
+        shape.scale(1.0 / a, b, c);
+        break;
+    case SetAcuteAngle:
+        shapeAs<Rhombus>(shape, "setAcuteAngle") = shapeAs<Rhombus>(*previous, "setAcuteAngle");
+        break;
+    case SetResolution:
+        shapeAs<Heart>(shape, "setResolution") = shapeAs<Heart>(*previous, "setResolution");
+        break;
+    default:
+        assign(type, shape, vertexIndex, oldA, oldB);
+        break;
+    }
+}
+
+CommandJournal::CommandJournal(size_t limit)
+    : maxCommands(limit)
+{
+}
+
+void CommandJournal::execute(Shape &shape, ShapeCommand command) {
+    command.captureState(shape);
+    command.apply(shape);
+
+    history.erase(history.begin() + cursor, history.end());
+    history.push_back(command);
+    cursor = history.size();
+    trim();
+}
+
+size_t CommandJournal::undo(const ShapeLookup &lookup) {
+    if (!canUndo()) {
+        throw std::logic_error("Нет команд для отмены");
+    }
+
+    const ShapeCommand &command = history[cursor - 1];
+    command.revert(lookup(command.shapeIndex));
+    --cursor;
+    return command.shapeIndex;
+}
+
+size_t CommandJournal::redo(const ShapeLookup &lookup) {
+    if (!canRedo()) {
+        throw std::logic_error("Нет команд для повтора");
+    }
+
+    const ShapeCommand &command = history[cursor];
+    command.apply(lookup(command.shapeIndex));
+    ++cursor;
+    return command.shapeIndex;
+}
+
+void CommandJournal::clear() {
+    history.clear();
+    cursor = 0;
+}
+
+void CommandJournal::setLimit(size_t limit) {
+    maxCommands = limit;
+    trim();
+}
+
+void CommandJournal::trim() {
+    if (history.size() <= maxCommands) return;
+
+    size_t excess = history.size() - maxCommands;
+    history.erase(history.begin(), history.begin() + excess);
+    cursor = cursor > excess ? cursor - excess : 0;
+}
@@ -0,0 +1,102 @@
+#ifndef COMMANDJOURNAL_H
+#define COMMANDJOURNAL_H
+
+#include "shape.h"
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+
+// Одна правка фигуры в виде параметров, а не снимка вершин.
+// Для установки значений хранится и прежнее значение, поэтому
+// отмена и повтор стоят O(1) независимо от числа вершин.
+struct ShapeCommand {
+    enum Type : unsigned char {
+        Move,
+        Rotate,
+        Scale,
+        SetVertex,
+        SetRadius,
+        SetSide,
+        SetWidth,
+        SetHeight,
+        SetAcuteAngle,
+        SetSize,
+        SetResolution
+    };
+
+    Type type;
+    uint32_t vertexIndex = 0;
+    size_t shapeIndex;
+
+    // Move: dx, dy; Rotate: угол, ox, oy; Scale: коэффициент, ox, oy;
+    // SetVertex: x, y; установка значения: новое значение в a
+    double a = 0.0;
+    double b = 0.0;
+    double c = 0.0;
+
+    // Прежние значения для установок (заполняет журнал)
+    double oldA = 0.0;
+    double oldB = 0.0;
+
+    // SetResolution и SetAcuteAngle строят вершины заново без
+    // накопленного поворота, поэтому прежнего значения для отмены мало:
+    // хранится копия фигуры (вершины у копий общие, так что копия не
+    // дороже параметров)
+    std::shared_ptr<const Shape> previous;
+
+    static ShapeCommand move(size_t shape, double dx, double dy);
+    static ShapeCommand rotate(size_t shape, double angleDeg, double originX, double originY);
+    static ShapeCommand scale(size_t shape, double factor, double originX, double originY);
+    static ShapeCommand setVertex(size_t shape, size_t vertex, const QPointF &point);
+    static ShapeCommand setRadius(size_t shape, double radius);
+    static ShapeCommand setSide(size_t shape, double side);
+    static ShapeCommand setWidth(size_t shape, double width);
+    static ShapeCommand setHeight(size_t shape, double height);
+    static ShapeCommand setAcuteAngle(size_t shape, double angle);
+    static ShapeCommand setSize(size_t shape, double size);
+    static ShapeCommand setResolution(size_t shape, int resolution);
+
+    // Запоминает текущие значения фигуры, которые команда перезапишет
+    void captureState(const Shape &shape);
+
+    void apply(Shape &shape) const;
+    void revert(Shape &shape) const;
+};
+
+class CommandJournal {
+public:
+    using ShapeLookup = std::function<Shape&(size_t)>;
+
+    explicit CommandJournal(size_t limit = 10000);
+
+    // Выполняет команду над фигурой и записывает её; история повтора сбрасывается
+    void execute(Shape &shape, ShapeCommand command);
+
+    bool canUndo() const { return cursor > 0; }
+    bool canRedo() const { return cursor < history.size(); }
+
+    // Индексы фигур, которые изменят следующие undo() и redo()
+    size_t undoTarget() const { return history[cursor - 1].shapeIndex; }
+    size_t redoTarget() const { return history[cursor].shapeIndex; }
+
+    // Возвращают индекс изменённой фигуры
+    size_t undo(const ShapeLookup &lookup);
+    size_t redo(const ShapeLookup &lookup);
+
+    void clear();
+    size_t size() const { return history.size(); }
+    size_t position() const { return cursor; }
+
+    void setLimit(size_t limit);
+    size_t getLimit() const { return maxCommands; }
+
+private:
+    std::deque<ShapeCommand> history;
+    size_t cursor = 0;
+    size_t maxCommands;
+
+    void trim();
+};
+
+#endif // COMMANDJOURNAL_H
@@ -0,0 +1,318 @@
+#include "coverage.h"
+#include "circle.h"
+#include "geometrycore.h"
+#include "parallel.h"
+#include "spatialindex.h"
+#include <algorithm>
+#include <cmath>
+
+static const size_t kShapesPerTask = 256;
+
+struct CoverageShape {
+    bool circle = false;
+    QPointF center;
+    double radius = 0.0;
+    // Положительный обход: внутренность слева от рёбер
+    std::vector<QPointF> polygon;
+    QRectF bounds;
+    double area = 0.0;
+};
+
+static bool boundsContain(const QRectF &bounds, const QPointF &p) {
+    return p.x() >= bounds.left() && p.x() <= bounds.right() && p.y() >= bounds.top() && p.y() <= bounds.bottom();
+}
+
+// Точка строго внутри (для многоугольника — правило чётности)
+static bool covers(const CoverageShape &shape, const QPointF &p) {
+    if (!boundsContain(shape.bounds, p)) return false;
+
+    if (shape.circle) {
+        const QPointF d = p - shape.center;
+        return d.x() * d.x() + d.y() * d.y() < shape.radius * shape.radius;
+    }
+
+    bool inside = false;
+    const std::vector<QPointF> &polygon = shape.polygon;
+    for (size_t i = 0, j = polygon.size() - 1; i < polygon.size(); j = i++) {
+        const QPointF &a = polygon[i];
+        const QPointF &b = polygon[j];
+        if ((a.y() > p.y()) != (b.y() > p.y()) &&
+            p.x() < (b.x() - a.x()) * (p.y() - a.y()) / (b.y() - a.y()) + a.x()) {
+            inside = !inside;
+        }
+    }
+    return inside;
+}
+
+// Параметры t ∈ (0, 1) точек отрезка a + t·(b - a) на окружности
+static void segmentCircleParameters(const QPointF &a, const QPointF &b, const QPointF &center, double radius,
+                                    std::vector<double> &out) {
+    const QPointF d = b - a;
+    const QPointF f = a - center;
+    const double qa = d.x() * d.x() + d.y() * d.y();
+    const double qb = 2.0 * (f.x() * d.x() + f.y() * d.y());
+    const double qc = f.x() * f.x() + f.y() * f.y() - radius * radius;
+    const double discriminant = qb * qb - 4.0 * qa * qc;
+    if (qa == 0.0 || discriminant < 0.0) return;
+
+    const double root = std::sqrt(discriminant);
+    for (double t : {(-qb - root) / (2.0 * qa), (-qb + root) / (2.0 * qa)}) {
+        if (t > 0.0 && t < 1.0) out.push_back(t);
+    }
+}
+
+// Параметры на отрезке ab точек, где его пересекает отрезок cd; для
+// лежащих на одной прямой отрезков — проекции концов cd
+static void segmentSegmentParameters(const QPointF &a, const QPointF &b, const QPointF &c, const QPointF &d,
+                                     double epsilon, std::vector<double> &out) {
+    const QPointF r = b - a;
+    const QPointF s = d - c;
+    const QPointF ac = c - a;
+    const double denominator = r.x() * s.y() - r.y() * s.x();
+    const double lengthR = std::sqrt(r.x() * r.x() + r.y() * r.y());
+    const double lengthS = std::sqrt(s.x() * s.x() + s.y() * s.y());
+
+    if (std::abs(denominator) <= 1e-12 * lengthR * lengthS) {
+        const double offset = std::abs(ac.x() * r.y() - ac.y() * r.x()) / lengthR;
+        if (offset > epsilon) return;
+        const double rr = lengthR * lengthR;
+        for (const QPointF &p : {c, d}) {
+            const double t = ((p.x() - a.x()) * r.x() + (p.y() - a.y()) * r.y()) / rr;
+            if (t > 0.0 && t < 1.0) out.push_back(t);
+        }
+        return;
+    }
+
+    const double t = (ac.x() * s.y() - ac.y() * s.x()) / denominator;
+    const double u = (ac.x() * r.y() - ac.y() * r.x()) / denominator;
+    if (t > 0.0 && t < 1.0 && u >= 0.0 && u <= 1.0) out.push_back(t);
+}
+
+// Углы точек пересечения окружности first с окружностью second
+static void circleCircleAngles(const CoverageShape &first, const CoverageShape &second, std::vector<double> &out) {
+    const QPointF d = second.center - first.center;
+    const double distance = std::sqrt(d.x() * d.x() + d.y() * d.y());
+    if (distance == 0.0 || distance >= first.radius + second.radius ||
+        distance <= std::abs(first.radius - second.radius)) {
+        return;
+    }
+
+    const double base = std::atan2(d.y(), d.x());
+    const double cosine = (first.radius * first.radius + distance * distance - second.radius * second.radius) /
+                          (2.0 * first.radius * distance);
+    const double spread = std::acos(std::clamp(cosine, -1.0, 1.0));
+    out.push_back(base - spread);
+    out.push_back(base + spread);
+}
+
+struct BoundaryContext {
+    const std::vector<CoverageShape> &shapes;
+    // Начало координат для x в ∮ x dy: ближе к фигурам — меньше потерь точности
+    QPointF origin;
+    // Сдвиг пробных точек с границы внутрь и наружу
+    double epsilon;
+};
+
+// Кусок границы фигуры index с серединой point и внешней нормалью normal
+// входит в границу объединения, если снаружи от него нет других фигур,
+// а изнутри — фигур с меньшим номером (они уже учли совпадающую границу)
+static bool onUnionBoundary(const BoundaryContext &context, size_t index, const std::vector<size_t> &neighbours,
+                            const QPointF &point, const QPointF &normal) {
+    const QPointF outside = point + normal * context.epsilon;
+    const QPointF inside = point - normal * context.epsilon;
+    for (size_t other : neighbours) {
+        if (covers(context.shapes[other], outside)) return false;
+        if (other < index && covers(context.shapes[other], inside)) return false;
+    }
+    return true;
+}
+
+static double polygonContribution(const BoundaryContext &context, size_t index, const std::vector<size_t> &neighbours) {
+    const CoverageShape &shape = context.shapes[index];
+    const std::vector<QPointF> &polygon = shape.polygon;
+    const double ox = context.origin.x();
+
+    // Рёбра соседних многоугольников, задевающие эту фигуру
+    const QRectF reach = shape.bounds.adjusted(-context.epsilon, -context.epsilon, context.epsilon, context.epsilon);
+    std::vector<std::pair<QPointF, QPointF>> foreignEdges;
+    for (size_t other : neighbours) {
+        const std::vector<QPointF> &ring = context.shapes[other].polygon;
+        for (size_t k = 0; k < ring.size(); ++k) {
+            const QPointF &c = ring[k];
+            const QPointF &d = ring[(k + 1) % ring.size()];
+            if (std::max(c.x(), d.x()) >= reach.left() && std::min(c.x(), d.x()) <= reach.right() &&
+                std::max(c.y(), d.y()) >= reach.top() && std::min(c.y(), d.y()) <= reach.bottom()) {
+                foreignEdges.emplace_back(c, d);
+            }
+        }
+    }
+
+    double sum = 0.0;
+    std::vector<double> cuts;
+    std::vector<size_t> near;
+    for (size_t i = 0; i < polygon.size(); ++i) {
+        const QPointF &a = polygon[i];
+        const QPointF &b = polygon[(i + 1) % polygon.size()];
+        const QPointF edge = b - a;
+        const double length = std::sqrt(edge.x() * edge.x() + edge.y() * edge.y());
+        if (length == 0.0) continue;
+        const QPointF normal(edge.y() / length, -edge.x() / length);
+
+        const QRectF edgeBounds = QRectF(std::min(a.x(), b.x()), std::min(a.y(), b.y()),
+                                         std::abs(edge.x()), std::abs(edge.y()))
+                                      .adjusted(-context.epsilon, -context.epsilon, context.epsilon, context.epsilon);
+        near.clear();
+        for (size_t other : neighbours) {
+            const QRectF &bounds = context.shapes[other].bounds;
+            if (bounds.left() <= edgeBounds.right() && edgeBounds.left() <= bounds.right() &&
+                bounds.top() <= edgeBounds.bottom() && edgeBounds.top() <= bounds.bottom()) {
+                near.push_back(other);
+            }
+        }
+
+        cuts.assign({0.0, 1.0});
+        for (size_t other : near) {
+            const CoverageShape &neighbour = context.shapes[other];
+            if (neighbour.circle) segmentCircleParameters(a, b, neighbour.center, neighbour.radius, cuts);
+        }
+        for (const auto &[c, d] : foreignEdges) {
+            if (std::max(c.x(), d.x()) < edgeBounds.left() || std::min(c.x(), d.x()) > edgeBounds.right() ||
+                std::max(c.y(), d.y()) < edgeBounds.top() || std::min(c.y(), d.y()) > edgeBounds.bottom()) {
+                continue;
+            }
+            segmentSegmentParameters(a, b, c, d, context.epsilon, cuts);
+        }
+        std::sort(cuts.begin(), cuts.end());
+
+        for (size_t k = 0; k + 1 < cuts.size(); ++k) {
+            if (cuts[k + 1] - cuts[k] <= 0.0) continue;
+            const QPointF from = a + edge * cuts[k];
+            const QPointF to = a + edge * cuts[k + 1];
+            if (!onUnionBoundary(context, index, near, (from + to) * 0.5, normal)) continue;
+            sum += (0.5 * (from.x() + to.x()) - ox) * (to.y() - from.y());
+        }
+    }
+    return sum;
+}
+
+static double circleContribution(const BoundaryContext &context, size_t index, const std::vector<size_t> &neighbours) {
+    const CoverageShape &shape = context.shapes[index];
+    const double r = shape.radius;
+    const double cx = shape.center.x() - context.origin.x();
+
+    std::vector<double> cuts;
+    for (size_t other : neighbours) {
+        const CoverageShape &neighbour = context.shapes[other];
+        if (neighbour.circle) {
+            circleCircleAngles(shape, neighbour, cuts);
+            continue;
+        }
+
+        std::vector<double> parameters;
+        const std::vector<QPointF> &ring = neighbour.polygon;
+        for (size_t k = 0; k < ring.size(); ++k) {
+            const QPointF &a = ring[k];
+            const QPointF &b = ring[(k + 1) % ring.size()];
+            parameters.clear();
+            segmentCircleParameters(a, b, shape.center, r, parameters);
+            for (double t : parameters) {
+                const QPointF p = a + (b - a) * t - shape.center;
+                cuts.push_back(std::atan2(p.y(), p.x()));
+            }
+        }
+    }
+
+    for (double &angle : cuts) {
+        angle = std::fmod(angle, 2.0 * M_PI);
+        if (angle < 0.0) angle += 2.0 * M_PI;
+    }
+    cuts.push_back(0.0);
+    cuts.push_back(2.0 * M_PI);
+    std::sort(cuts.begin(), cuts.end());
+
+    // ∫ x dy по дуге: x = cx + r cos θ, dy = r cos θ dθ
+    auto primitive = [&](double theta) {
+        return cx * r * std::sin(theta) + 0.5 * r * r * (theta + std::sin(theta) * std::cos(theta));
+    };
+
+    double sum = 0.0;
+    for (size_t k = 0; k + 1 < cuts.size(); ++k) {
+        if (cuts[k + 1] - cuts[k] <= 0.0) continue;
+        const double middle = 0.5 * (cuts[k] + cuts[k + 1]);
+        const QPointF normal(std::cos(middle), std::sin(middle));
+        if (!onUnionBoundary(context, index, neighbours, shape.center + normal * r, normal)) continue;
+        sum += primitive(cuts[k + 1]) - primitive(cuts[k]);
+    }
+    return sum;
+}
+
+double coveredArea(const std::vector<const Shape*> &input) {
+    std::vector<CoverageShape> shapes(input.size());
+    parallelFor(input.size(), [&](size_t i) {
+        CoverageShape &shape = shapes[i];
+        if (const Circle *circle = dynamic_cast<const Circle*>(input[i])) {
+            shape.circle = true;
+            shape.center = circle->centerOfMass();
+            shape.radius = circle->getRadius();
+            shape.bounds = QRectF(shape.center.x() - shape.radius, shape.center.y() - shape.radius,
+                                  2.0 * shape.radius, 2.0 * shape.radius);
+            shape.area = M_PI * shape.radius * shape.radius;
+            return;
+        }
+
+        shape.polygon = input[i]->outline();
+        if (shape.polygon.size() < 3) return;
+
+        double signedArea = 0.0;
+        for (size_t k = 1; k + 1 < shape.polygon.size(); ++k) {
+            const QPointF a = shape.polygon[k] - shape.polygon[0];
+            const QPointF b = shape.polygon[k + 1] - shape.polygon[0];
+            signedArea += a.x() * b.y() - a.y() * b.x();
+        }
+        if (signedArea < 0.0) std::reverse(shape.polygon.begin(), shape.polygon.end());
+
+        shape.bounds = boundingRectOf(shape.polygon);
+        shape.area = polygonArea(shape.polygon.data(), shape.polygon.size());
+    });
+
+    QRectF sceneBounds;
+    double sizeSum = 0.0;
+    for (const CoverageShape &shape : shapes) {
+        sceneBounds = sceneBounds.united(shape.bounds);
+        sizeSum += std::max(shape.bounds.width(), shape.bounds.height());
+    }
+
+    SpatialIndex index(shapes.empty() ? 1.0 : std::max(1e-9, 2.0 * sizeSum / shapes.size()));
+    for (size_t i = 0; i < shapes.size(); ++i) {
+        if (shapes[i].circle || shapes[i].polygon.size() >= 3) index.insert(i, shapes[i].bounds);
+    }
+
+    const double extent = std::max({1.0, sceneBounds.width(), sceneBounds.height()});
+    const BoundaryContext context{shapes, sceneBounds.center(), 1e-9 * extent};
+
+    const size_t taskCount = (shapes.size() + kShapesPerTask - 1) / kShapesPerTask;
+    std::vector<double> partial(taskCount, 0.0);
+    parallelFor(taskCount, [&](size_t task) {
+        const size_t end = std::min(shapes.size(), (task + 1) * kShapesPerTask);
+        for (size_t i = task * kShapesPerTask; i < end; ++i) {
+            if (!index.contains(i)) continue;
+
+            const QRectF probe = shapes[i].bounds.adjusted(-context.epsilon, -context.epsilon,
+                                                          context.epsilon, context.epsilon);
+            std::vector<size_t> neighbours = index.query(probe);
+            neighbours.erase(std::remove(neighbours.begin(), neighbours.end(), i), neighbours.end());
+
+            if (neighbours.empty()) {
+                partial[task] += shapes[i].area;
+            } else if (shapes[i].circle) {
+                partial[task] += circleContribution(context, i, neighbours);
+            } else {
+                partial[task] += polygonContribution(context, i, neighbours);
+            }
+        }
+    });
+
+    double total = 0.0;
+    for (double value : partial) total += value;
+    return total;
+}
@@ -0,0 +1,22 @@
+#ifndef COVERAGE_H
+#define COVERAGE_H
+
+#include "shape.h"
+#include <vector>
+
+// Площадь объединения фигур — сколько материала они действительно
+// покрывают, без двойного учёта перекрытий.
+//
+// Считается по формуле Грина: площадь = ∮ x dy по границе объединения.
+// Граница объединения состоит из тех участков границ фигур, которые не
+// лежат внутри других фигур. Граница каждой фигуры режется в точках
+// пересечения с соседями (по ограничивающим прямоугольникам), и
+// интеграл берётся по непокрытым кускам: для многоугольников — по
+// отрезкам, для кругов — по дугам точно. Совпадающие участки границ
+// (одинаковые фигуры, общие стороны) учитываются один раз.
+//
+// Фигуры обрабатываются параллельно; фигура без соседей даёт свою
+// площадь сразу. Круги берутся точно, остальные фигуры — по outline().
+double coveredArea(const std::vector<const Shape*> &shapes);
+
+#endif // COVERAGE_H
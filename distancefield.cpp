@@ -0,0 +1,200 @@
+#include "distancefield.h"
+#include "parallel.h"
+#include "spatialindex.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+static const int kTileSize = 32;
+// Блок дробится, пока кандидатов больше этого числа и сторона больше kMinBlock
+static const size_t kLeafCandidates = 2;
+static const int kMinBlock = 8;
+
+DistanceField::DistanceField(const QRectF &area, int columns, int rows)
+    : bounds(area), columnCount(columns), rowCount(rows)
+{
+    if (columns <= 0 || rows <= 0) {
+        throw std::invalid_argument(
+            "Размеры сетки должны быть положительными. Передано: " +
+            std::to_string(columns) + "x" + std::to_string(rows)
+            );
+    }
+
+    if (area.width() <= 0.0 || area.height() <= 0.0) {
+        throw std::invalid_argument("Область поля расстояний не должна быть пустой");
+    }
+
+    values.assign(static_cast<size_t>(columns) * rows, 0.0f);
+}
+
+QPointF DistanceField::cellCenter(int column, int row) const {
+    return QPointF(bounds.left() + (column + 0.5) * cellWidth(),
+                   bounds.top() + (row + 0.5) * cellHeight());
+}
+
+// Ни одна точка плитки не ближе к фигуре внутри box
+static double lowerBound(const QRectF &tile, const QRectF &box) {
+    double dx = std::max({0.0, box.left() - tile.right(), tile.left() - box.right()});
+    double dy = std::max({0.0, box.top() - tile.bottom(), tile.top() - box.bottom()});
+    return std::sqrt(dx * dx + dy * dy);
+}
+
+// Граница фигуры касается каждой стороны box, поэтому от любой точки
+// плитки до неё не дальше, чем до самого далёкого угла box
+static double upperBound(const QRectF &tile, const QRectF &box) {
+    double dx = std::max(std::abs(tile.right() - box.left()), std::abs(box.right() - tile.left()));
+    double dy = std::max(std::abs(tile.bottom() - box.top()), std::abs(box.bottom() - tile.top()));
+    return std::sqrt(dx * dx + dy * dy);
+}
+
+struct FieldContext {
+    const std::vector<const Shape*> &shapes;
+    DistanceField &field;
+    double maxDistance;
+};
+
+// Заполняет блок ячеек [column0, column0 + width) × [row0, row0 + height).
+// Расстояние со знаком 1-липшицево: по значению в центре блока оно
+// ограничено для всех точек блока с точностью до половины диагонали.
+// Поэтому фигура, которая даже в лучшем случае дальше, чем чья-то
+// другая в худшем, для блока не нужна.
+static void fillBlock(const FieldContext &context, int column0, int row0, int width, int height,
+                      const std::vector<size_t> &candidates) {
+    DistanceField &field = context.field;
+    const double cellWidth = field.cellWidth();
+    const double cellHeight = field.cellHeight();
+    const QPointF first = field.cellCenter(column0, row0);
+    const QPointF center(first.x() + 0.5 * (width - 1) * cellWidth,
+                         first.y() + 0.5 * (height - 1) * cellHeight);
+    const double halfDiagonal = 0.5 * std::hypot((width - 1) * cellWidth, (height - 1) * cellHeight);
+
+    std::vector<double> atCenter(candidates.size());
+    double reach = context.maxDistance;
+    for (size_t k = 0; k < candidates.size(); ++k) {
+        atCenter[k] = context.shapes[candidates[k]]->signedDistance(center);
+        reach = std::min(reach, atCenter[k] + halfDiagonal);
+    }
+
+    std::vector<size_t> kept;
+    for (size_t k = 0; k < candidates.size(); ++k) {
+        if (atCenter[k] - halfDiagonal <= reach) kept.push_back(candidates[k]);
+    }
+
+    if (kept.size() > kLeafCandidates && (width > kMinBlock || height > kMinBlock)) {
+        const int leftWidth = (width + 1) / 2;
+        const int topHeight = (height + 1) / 2;
+        fillBlock(context, column0, row0, leftWidth, topHeight, kept);
+        if (width > leftWidth) fillBlock(context, column0 + leftWidth, row0, width - leftWidth, topHeight, kept);
+        if (height > topHeight) fillBlock(context, column0, row0 + topHeight, leftWidth, height - topHeight, kept);
+        if (width > leftWidth && height > topHeight) {
+            fillBlock(context, column0 + leftWidth, row0 + topHeight, width - leftWidth, height - topHeight, kept);
+        }
+        return;
+    }
+
+    const size_t count = static_cast<size_t>(width) * height;
+    std::vector<double> best(count, context.maxDistance);
+
+    if (!kept.empty()) {
+        std::vector<double> xs(count);
+        std::vector<double> ys(count);
+        for (int r = 0; r < height; ++r) {
+            for (int c = 0; c < width; ++c) {
+                xs[static_cast<size_t>(r) * width + c] = first.x() + c * cellWidth;
+                ys[static_cast<size_t>(r) * width + c] = first.y() + r * cellHeight;
+            }
+        }
+
+        std::vector<double> distances(count);
+        for (size_t id : kept) {
+            context.shapes[id]->signedDistances(xs.data(), ys.data(), distances.data(), count);
+            for (size_t i = 0; i < count; ++i) {
+                best[i] = std::min(best[i], distances[i]);
+            }
+        }
+    }
+
+    for (int r = 0; r < height; ++r) {
+        for (int c = 0; c < width; ++c) {
+            double value = std::max(best[static_cast<size_t>(r) * width + c], -context.maxDistance);
+            field.at(column0 + c, row0 + r) = static_cast<float>(value);
+        }
+    }
+}
+
+DistanceField computeDistanceField(const std::vector<const Shape*> &shapes, const QRectF &area,
+                                   int columns, int rows, double maxDistance) {
+    if (!(maxDistance > 0.0)) {
+        throw std::invalid_argument(
+            "Предел расстояния должен быть положительным. Передано: " + std::to_string(maxDistance)
+            );
+    }
+
+    DistanceField field(area, columns, rows);
+
+    std::vector<QRectF> boxes;
+    boxes.reserve(shapes.size());
+    QRectF sceneBounds = area;
+    double sizeSum = 0.0;
+    for (const Shape *shape : shapes) {
+        boxes.push_back(shape->boundingRect());
+        sceneBounds = sceneBounds.united(boxes.back());
+        sizeSum += std::max(boxes.back().width(), boxes.back().height());
+    }
+
+    const double cellWidth = field.cellWidth();
+    const double cellHeight = field.cellHeight();
+    double indexCell = shapes.empty() ? 1.0 : sizeSum / shapes.size();
+    indexCell = std::max({indexCell, kTileSize * cellWidth, kTileSize * cellHeight});
+
+    SpatialIndex index(indexCell);
+    for (size_t i = 0; i < boxes.size(); ++i) {
+        index.insert(i, boxes[i]);
+    }
+
+    // Дальше этого радиуса поиск находит все фигуры сцены
+    const double searchLimit = std::min(maxDistance, std::hypot(sceneBounds.width(), sceneBounds.height()));
+
+    const int tileColumns = (columns + kTileSize - 1) / kTileSize;
+    const int tileRows = (rows + kTileSize - 1) / kTileSize;
+    const FieldContext context{shapes, field, maxDistance};
+
+    parallelFor(static_cast<size_t>(tileColumns) * tileRows, [&](size_t tileIndex) {
+        const int column0 = static_cast<int>(tileIndex % tileColumns) * kTileSize;
+        const int row0 = static_cast<int>(tileIndex / tileColumns) * kTileSize;
+        const int tileWidth = std::min(kTileSize, columns - column0);
+        const int tileHeight = std::min(kTileSize, rows - row0);
+
+        // Прямоугольник центров ячеек плитки
+        const QPointF first = field.cellCenter(column0, row0);
+        const QRectF tile(first.x(), first.y(), (tileWidth - 1) * cellWidth, (tileHeight - 1) * cellHeight);
+
+        // Ближайшие фигуры ищутся расширяющимся окном; по их
+        // прямоугольникам оценивается сверху, дальше какого расстояния
+        // фигуры для плитки уже не важны
+        std::vector<size_t> nearby;
+        double radius = std::max(tile.width(), tile.height()) + std::max(cellWidth, cellHeight);
+        for (;;) {
+            nearby = index.query(tile.adjusted(-radius, -radius, radius, radius));
+            if (!nearby.empty() || radius >= searchLimit) break;
+            radius = std::min(2.0 * radius, searchLimit);
+        }
+
+        double reach = maxDistance;
+        for (size_t id : nearby) {
+            reach = std::min(reach, upperBound(tile, boxes[id]));
+        }
+
+        std::vector<size_t> candidates;
+        if (!nearby.empty()) {
+            for (size_t id : index.query(tile.adjusted(-reach, -reach, reach, reach))) {
+                if (lowerBound(tile, boxes[id]) <= reach) candidates.push_back(id);
+            }
+        }
+
+        fillBlock(context, column0, row0, tileWidth, tileHeight, candidates);
+    });
+
+    return field;
+}
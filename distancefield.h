@@ -0,0 +1,50 @@
+#ifndef DISTANCEFIELD_H
+#define DISTANCEFIELD_H
+
+#include "shape.h"
+#include <QRectF>
+#include <limits>
+#include <vector>
+
+// Поле знаковых расстояний до объединения фигур на регулярной сетке:
+// значение ячейки — расстояние от её центра до ближайшей границы,
+// внутри фигур отрицательное.
+class DistanceField {
+private:
+    QRectF bounds;
+    int columnCount;
+    int rowCount;
+    std::vector<float> values;
+
+public:
+    DistanceField(const QRectF &area, int columns, int rows);
+
+    const QRectF &area() const { return bounds; }
+    int columns() const { return columnCount; }
+    int rows() const { return rowCount; }
+
+    double cellWidth() const { return bounds.width() / columnCount; }
+    double cellHeight() const { return bounds.height() / rowCount; }
+    QPointF cellCenter(int column, int row) const;
+
+    float at(int column, int row) const { return values[static_cast<size_t>(row) * columnCount + column]; }
+    float &at(int column, int row) { return values[static_cast<size_t>(row) * columnCount + column]; }
+
+    // Строки подряд, columns() значений в строке
+    const float *data() const { return values.data(); }
+};
+
+// Поле строится плитками параллельно. Для плитки рассматриваются только
+// фигуры, чей ограничивающий прямоугольник может оказаться ближе, чем
+// гарантированно достижимая граница ближайшей фигуры; остальные
+// отбрасываются без вычисления расстояний. Затем плитка дробится на
+// блоки, пока в каждом не останется одна-две фигуры-кандидата.
+//
+// При конечном maxDistance значения обрезаются до [-maxDistance, maxDistance],
+// а фигуры дальше maxDistance не рассматриваются вовсе.
+// Фигуры должны быть материализованы (Shape::materialize).
+DistanceField computeDistanceField(const std::vector<const Shape*> &shapes, const QRectF &area,
+                                   int columns, int rows,
+                                   double maxDistance = std::numeric_limits<double>::infinity());
+
+#endif // DISTANCEFIELD_H
@@ -0,0 +1,352 @@
+#include "fixedpolygon.h"
+#include "instrumentation.h"
+#include <algorithm>
+#include <cmath>
+
+// Сумма int64 без переполнения: старшие и младшие 32 бита слагаемых
+// накапливаются отдельно, значение = high · 2^32 + low
+class WideSum {
+private:
+    int64_t high = 0;
+    uint64_t low = 0;
+
+public:
+    void add(int64_t value) {
+        high += value >> 32;
+        low += static_cast<uint64_t>(value) & 0xffffffffu;
+        high += static_cast<int64_t>(low >> 32);
+        low &= 0xffffffffu;
+    }
+
+    int sign() const {
+        if (high != 0) return high > 0 ? 1 : -1;
+        return low != 0 ? 1 : 0;
+    }
+
+    double toDouble() const {
+        return std::ldexp(static_cast<double>(high), 32) + static_cast<double>(low);
+    }
+};
+
+// Удвоенная площадь со знаком; векторные произведения от первой вершины
+static WideSum twiceArea(const std::vector<FixedPoint> &points) {
+    WideSum sum;
+    const FixedPoint &anchor = points[0];
+    for (size_t i = 1; i + 1 < points.size(); ++i) {
+        const int64_t ax = static_cast<int64_t>(points[i].x) - anchor.x;
+        const int64_t ay = static_cast<int64_t>(points[i].y) - anchor.y;
+        const int64_t bx = static_cast<int64_t>(points[i + 1].x) - anchor.x;
+        const int64_t by = static_cast<int64_t>(points[i + 1].y) - anchor.y;
+        sum.add(ax * by);
+        sum.add(-(ay * bx));
+    }
+    return sum;
+}
+
+static bool isNearInteger(double value) {
+    return std::abs(value - std::round(value)) < 1e-9;
+}
+
+static int32_t checkedCoordinate(int64_t value) {
+    if (value < -FixedPolygon::kFixedLimit || value > FixedPolygon::kFixedLimit) {
+        throw std::out_of_range(
+            "Координата выходит за пределы фиксированной сетки (±2^30 шагов). Получено: " +
+            std::to_string(value)
+            );
+    }
+    return static_cast<int32_t>(value);
+}
+
+FixedPolygon::FixedPolygon(const std::vector<QPointF> &verts, double resolution)
+    : Shape(0.0, 0.0), step(resolution)
+{
+    if (!(resolution > 0.0)) {
+        throw std::invalid_argument(
+            "Шаг сетки должен быть положительным. Передано: " + std::to_string(resolution)
+            );
+    }
+
+    if (verts.size() < 3) {
+        throw std::invalid_argument(
+            "Многоугольник должен иметь минимум 3 вершины. Передано: " +
+            std::to_string(verts.size())
+            );
+    }
+
+    points.reserve(verts.size());
+    for (const QPointF &v : verts) {
+        points.push_back(toGrid(v.x(), v.y()));
+    }
+
+    updateCenter();
+}
+
+FixedPolygon::FixedPolygon(std::vector<FixedPoint> verts, double resolution)
+    : Shape(0.0, 0.0), points(std::move(verts)), step(resolution)
+{
+    if (!(resolution > 0.0)) {
+        throw std::invalid_argument(
+            "Шаг сетки должен быть положительным. Передано: " + std::to_string(resolution)
+            );
+    }
+
+    if (points.size() < 3) {
+        throw std::invalid_argument(
+            "Многоугольник должен иметь минимум 3 вершины. Передано: " +
+            std::to_string(points.size())
+            );
+    }
+
+    for (const FixedPoint &p : points) {
+        checkedCoordinate(p.x);
+        checkedCoordinate(p.y);
+    }
+
+    updateCenter();
+}
+
+FixedPoint FixedPolygon::toGrid(double x, double y) const {
+    const double gx = std::round(x / step);
+    const double gy = std::round(y / step);
+    if (!(std::abs(gx) <= kFixedLimit) || !(std::abs(gy) <= kFixedLimit)) {
+        throw std::out_of_range(
+            "Точка выходит за пределы фиксированной сетки (±2^30 шагов): (" +
+            std::to_string(x) + ", " + std::to_string(y) + ")"
+            );
+    }
+    return FixedPoint{static_cast<int32_t>(gx), static_cast<int32_t>(gy)};
+}
+
+QPointF FixedPolygon::toScene(const FixedPoint &point) const {
+    return QPointF(point.x * step, point.y * step);
+}
+
+void FixedPolygon::updateCenter() {
+    SHAPE_PROBE_SHAPE(CenterOfMass);
+
+    // Центр масс в double по треугольникам веера от первой вершины
+    const FixedPoint &anchor = points[0];
+    double totalArea = 0.0;
+    double weightedX = 0.0;
+    double weightedY = 0.0;
+    for (size_t i = 1; i + 1 < points.size(); ++i) {
+        const double ax = static_cast<double>(points[i].x) - anchor.x;
+        const double ay = static_cast<double>(points[i].y) - anchor.y;
+        const double bx = static_cast<double>(points[i + 1].x) - anchor.x;
+        const double by = static_cast<double>(points[i + 1].y) - anchor.y;
+        const double area = ax * by - ay * bx;
+        weightedX += area * (ax + bx) / 3.0;
+        weightedY += area * (ay + by) / 3.0;
+        totalArea += area;
+    }
+
+    double localX = 0.0;
+    double localY = 0.0;
+    if (twiceArea(points).sign() != 0 && totalArea != 0.0) {
+        localX = weightedX / totalArea;
+        localY = weightedY / totalArea;
+    } else {
+        for (const FixedPoint &p : points) {
+            localX += static_cast<double>(p.x) - anchor.x;
+            localY += static_cast<double>(p.y) - anchor.y;
+        }
+        localX /= points.size();
+        localY /= points.size();
+    }
+
+    centerX = (anchor.x + localX) * step;
+    centerY = (anchor.y + localY) * step;
+}
+
+double FixedPolygon::area() const {
+    SHAPE_PROBE_SHAPE(Area);
+    return std::abs(twiceArea(points).toDouble()) * 0.5 * step * step;
+}
+
+double FixedPolygon::perimeter() const {
+    SHAPE_PROBE_SHAPE(Perimeter);
+
+    double perimeter = 0.0;
+    for (size_t i = 0; i < points.size(); ++i) {
+        const FixedPoint &a = points[i];
+        const FixedPoint &b = points[(i + 1) % points.size()];
+        perimeter += std::hypot(static_cast<double>(b.x) - a.x, static_cast<double>(b.y) - a.y);
+    }
+    return perimeter * step;
+}
+
+void FixedPolygon::move(double dx, double dy) {
+    SHAPE_PROBE_SHAPE(Move);
+
+    const int64_t gridDx = std::llround(dx / step);
+    const int64_t gridDy = std::llround(dy / step);
+
+    std::vector<FixedPoint> moved(points.size());
+    for (size_t i = 0; i < points.size(); ++i) {
+        moved[i].x = checkedCoordinate(points[i].x + gridDx);
+        moved[i].y = checkedCoordinate(points[i].y + gridDy);
+    }
+
+    points.swap(moved);
+    updateCenter();
+}
+
+void FixedPolygon::rotate(double angleDeg, double originX, double originY) {
+    SHAPE_PROBE_SHAPE(Rotate);
+
+    const double quarterTurns = angleDeg / 90.0;
+    const double gridOriginX = originX / step;
+    const double gridOriginY = originY / step;
+    std::vector<FixedPoint> rotated(points.size());
+
+    if (isNearInteger(quarterTurns) && isNearInteger(gridOriginX) && isNearInteger(gridOriginY)) {
+        // Поворот на четверть оборота вокруг узла переводит узлы в узлы
+        const int turns = static_cast<int>(((std::llround(quarterTurns) % 4) + 4) % 4);
+        const int64_t ox = std::llround(gridOriginX);
+        const int64_t oy = std::llround(gridOriginY);
+        for (size_t i = 0; i < points.size(); ++i) {
+            int64_t x = points[i].x - ox;
+            int64_t y = points[i].y - oy;
+            for (int t = 0; t < turns; ++t) {
+                const int64_t previousX = x;
+                x = -y;
+                y = previousX;
+            }
+            rotated[i].x = checkedCoordinate(ox + x);
+            rotated[i].y = checkedCoordinate(oy + y);
+        }
+    } else {
+        for (size_t i = 0; i < points.size(); ++i) {
+            const QPointF p = rotatePoint(toScene(points[i]), angleDeg, originX, originY);
+            rotated[i] = toGrid(p.x(), p.y());
+        }
+    }
+
+    points.swap(rotated);
+    updateCenter();
+}
+
+void FixedPolygon::scale(double factor, double originX, double originY) {
+    SHAPE_PROBE_SHAPE(Scale);
+    if (factor <= 0.0) {
+        throw std::invalid_argument(
+            "Коэффициент масштабирования должен быть положительным. "
+            "Передано: " + std::to_string(factor)
+            );
+    }
+
+    const double gridOriginX = originX / step;
+    const double gridOriginY = originY / step;
+    std::vector<FixedPoint> scaled(points.size());
+
+    if (isNearInteger(factor) && isNearInteger(gridOriginX) && isNearInteger(gridOriginY)) {
+        const int64_t k = std::llround(factor);
+        const int64_t ox = std::llround(gridOriginX);
+        const int64_t oy = std::llround(gridOriginY);
+        if (k > 2 * static_cast<int64_t>(kFixedLimit)) {
+            throw std::out_of_range("Коэффициент масштабирования выводит фигуру за пределы сетки");
+        }
+        for (size_t i = 0; i < points.size(); ++i) {
+            scaled[i].x = checkedCoordinate(ox + k * (points[i].x - ox));
+            scaled[i].y = checkedCoordinate(oy + k * (points[i].y - oy));
+        }
+    } else {
+        for (size_t i = 0; i < points.size(); ++i) {
+            const QPointF p = scalePoint(toScene(points[i]), factor, originX, originY);
+            scaled[i] = toGrid(p.x(), p.y());
+        }
+    }
+
+    points.swap(scaled);
+    updateCenter();
+}
+
+void FixedPolygon::draw(QPainter &painter) const {
+    SHAPE_PROBE_SHAPE(Draw);
+
+    QPolygonF polygon;
+    for (const FixedPoint &p : points) {
+        polygon << toScene(p);
+    }
+    drawPolygonShape(painter, polygon, QPointF(centerX, centerY));
+}
+
+QRectF FixedPolygon::boundingRect() const {
+    int32_t minX = points[0].x;
+    int32_t maxX = minX;
+    int32_t minY = points[0].y;
+    int32_t maxY = minY;
+
+    for (const FixedPoint &p : points) {
+        minX = std::min(minX, p.x);
+        maxX = std::max(maxX, p.x);
+        minY = std::min(minY, p.y);
+        maxY = std::max(maxY, p.y);
+    }
+
+    return QRectF(minX * step, minY * step,
+                  (static_cast<double>(maxX) - minX) * step, (static_cast<double>(maxY) - minY) * step);
+}
+
+std::vector<QPointF> FixedPolygon::outline() const {
+    std::vector<QPointF> result;
+    result.reserve(points.size());
+    for (const FixedPoint &p : points) {
+        result.push_back(toScene(p));
+    }
+    return result;
+}
+
+int FixedPolygon::orientation(const FixedPoint &a, const FixedPoint &b, const FixedPoint &c) {
+    // Разности до 2^31, произведения до 2^62: сравниваются без вычитания
+    const int64_t left = (static_cast<int64_t>(b.x) - a.x) * (static_cast<int64_t>(c.y) - a.y);
+    const int64_t right = (static_cast<int64_t>(b.y) - a.y) * (static_cast<int64_t>(c.x) - a.x);
+    return (left > right) - (left < right);
+}
+
+int FixedPolygon::orientation() const {
+    return twiceArea(points).sign();
+}
+
+bool FixedPolygon::isConvex() const {
+    const size_t n = points.size();
+    int turn = 0;
+    int directionChanges = 0;
+    int firstDirection = 0;
+    int previousDirection = 0;
+
+    for (size_t i = 0; i < n; ++i) {
+        const FixedPoint &a = points[i];
+        const FixedPoint &b = points[(i + 1) % n];
+        const FixedPoint &c = points[(i + 2) % n];
+
+        const int current = orientation(a, b, c);
+        if (current != 0) {
+            if (turn != 0 && current != turn) return false;
+            turn = current;
+        }
+
+        // Выпуклый контур обходит x-проекцию туда и обратно один раз;
+        // самопересекающаяся звезда с поворотами одного знака — больше
+        const int direction = (b.x > a.x) - (b.x < a.x);
+        if (direction != 0) {
+            if (firstDirection == 0) firstDirection = direction;
+            if (previousDirection != 0 && direction != previousDirection) ++directionChanges;
+            previousDirection = direction;
+        }
+    }
+    if (previousDirection != firstDirection) ++directionChanges;
+
+    return turn != 0 && directionChanges <= 2;
+}
+
+bool FixedPolygon::isParallelogram() const {
+    if (points.size() != 4) return false;
+
+    const int64_t sumX02 = static_cast<int64_t>(points[0].x) + points[2].x;
+    const int64_t sumY02 = static_cast<int64_t>(points[0].y) + points[2].y;
+    const int64_t sumX13 = static_cast<int64_t>(points[1].x) + points[3].x;
+    const int64_t sumY13 = static_cast<int64_t>(points[1].y) + points[3].y;
+
+    return sumX02 == sumX13 && sumY02 == sumY13 && orientation(points[0], points[1], points[2]) != 0;
+}
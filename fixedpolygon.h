@@ -0,0 +1,71 @@
+#ifndef FIXEDPOLYGON_H
+#define FIXEDPOLYGON_H
+
+#include "shape.h"
+#include <cstdint>
+#include <vector>
+
+// Вершина на целочисленной сетке: координата = значение · resolution
+struct FixedPoint {
+    int32_t x;
+    int32_t y;
+
+    bool operator==(const FixedPoint &other) const { return x == other.x && y == other.y; }
+    bool operator!=(const FixedPoint &other) const { return !(*this == other); }
+};
+
+// Многоугольник с вершинами на сетке с шагом resolution (например,
+// 0.001 для данных с сеткой 1 мкм при единицах сцены в миллиметрах).
+// Вершина занимает 8 байт вместо 16 у QPointF.
+//
+// Координаты по модулю не больше kFixedLimit = 2^30: тогда разности
+// помещаются в int32, а векторные произведения — в int64, и площадь,
+// ориентация, выпуклость и параллельность сторон считаются точно,
+// без допусков.
+//
+// Сдвиг на кратное шагу, поворот на кратный 90° угол и целое
+// масштабирование вокруг узла сетки точны; прочие преобразования
+// округляют вершины до ближайших узлов.
+class FixedPolygon : public Shape {
+private:
+    std::vector<FixedPoint> points;
+    double step;
+
+    void updateCenter();
+    FixedPoint toGrid(double x, double y) const;
+    QPointF toScene(const FixedPoint &point) const;
+
+public:
+    static const int32_t kFixedLimit = 1 << 30;
+
+    FixedPolygon(const std::vector<QPointF> &verts, double resolution = 1.0);
+
+    FixedPolygon(std::vector<FixedPoint> verts, double resolution);
+
+    double area() const override;
+    double perimeter() const override;
+    void move(double dx, double dy) override;
+    void rotate(double angleDeg, double originX, double originY) override;
+    void scale(double factor, double originX, double originY) override;
+    void draw(QPainter &painter) const override;
+    QRectF boundingRect() const override;
+    std::vector<QPointF> outline() const override;
+    std::unique_ptr<Shape> clone() const override { return std::make_unique<FixedPolygon>(*this); }
+
+    double resolution() const { return step; }
+    size_t vertexCount() const { return points.size(); }
+    const std::vector<FixedPoint> &fixedVertices() const { return points; }
+
+    // Знак удвоенной площади: 1 — положительный обход, -1 — обратный, 0 — вырожден
+    int orientation() const;
+
+    bool isConvex() const;
+
+    // Для четырёх вершин: диагонали делятся пополам в одной точке
+    bool isParallelogram() const;
+
+    // Знак векторного произведения (b - a) × (c - a), точно
+    static int orientation(const FixedPoint &a, const FixedPoint &b, const FixedPoint &c);
+};
+
+#endif // FIXEDPOLYGON_H
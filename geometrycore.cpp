@@ -0,0 +1,135 @@
+#include "geometrycore.h"
+#include <cmath>
+
+template <typename P>
+P rotatedPoint(const P &point, ScalarOf<P> angleDeg, ScalarOf<P> originX, ScalarOf<P> originY) {
+    P result = point;
+    rotatePoints(&result, 1, angleDeg, originX, originY);
+    return result;
+}
+
+template <typename P>
+P scaledPoint(const P &point, ScalarOf<P> factor, ScalarOf<P> originX, ScalarOf<P> originY) {
+    P result = point;
+    scalePoints(&result, 1, factor, originX, originY);
+    return result;
+}
+
+template <typename P>
+void rotatePoints(P *points, size_t count, ScalarOf<P> angleDeg, ScalarOf<P> originX, ScalarOf<P> originY) {
+    using T = ScalarOf<P>;
+    using Traits = PointTraits<P>;
+
+    const T angleRad = angleDeg * static_cast<T>(M_PI / 180.0);
+    const T cosA = std::cos(angleRad);
+    const T sinA = std::sin(angleRad);
+
+    for (size_t i = 0; i < count; ++i) {
+        const T dx = Traits::x(points[i]) - originX;
+        const T dy = Traits::y(points[i]) - originY;
+        points[i] = Traits::make(originX + dx * cosA - dy * sinA,
+                                 originY + dx * sinA + dy * cosA);
+    }
+}
+
+template <typename P>
+void scalePoints(P *points, size_t count, ScalarOf<P> factor, ScalarOf<P> originX, ScalarOf<P> originY) {
+    using T = ScalarOf<P>;
+    using Traits = PointTraits<P>;
+
+    for (size_t i = 0; i < count; ++i) {
+        const T dx = Traits::x(points[i]) - originX;
+        const T dy = Traits::y(points[i]) - originY;
+        points[i] = Traits::make(originX + dx * factor, originY + dy * factor);
+    }
+}
+
+template <typename P>
+ScalarOf<P> polygonArea(const P *points, size_t count) {
+    using T = ScalarOf<P>;
+    using Traits = PointTraits<P>;
+    if (count < 3) return T(0);
+
+    // Координаты от первой вершины: во float далёкие от начала координат
+    // фигуры иначе теряют площадь целиком
+    const T anchorX = Traits::x(points[0]);
+    const T anchorY = Traits::y(points[0]);
+    T area = T(0);
+    for (size_t i = 1; i + 1 < count; ++i) {
+        const T ax = Traits::x(points[i]) - anchorX;
+        const T ay = Traits::y(points[i]) - anchorY;
+        const T bx = Traits::x(points[i + 1]) - anchorX;
+        const T by = Traits::y(points[i + 1]) - anchorY;
+        area += ax * by - ay * bx;
+    }
+
+    return std::abs(area) * T(0.5);
+}
+
+template <typename P>
+ScalarOf<P> polygonPerimeter(const P *points, size_t count) {
+    using T = ScalarOf<P>;
+    using Traits = PointTraits<P>;
+    if (count < 3) return T(0);
+
+    T perimeter = T(0);
+    for (size_t i = 0; i < count; ++i) {
+        const size_t j = (i + 1) % count;
+        const T dx = Traits::x(points[j]) - Traits::x(points[i]);
+        const T dy = Traits::y(points[j]) - Traits::y(points[i]);
+        perimeter += std::sqrt(dx * dx + dy * dy);
+    }
+
+    return perimeter;
+}
+
+template <typename P>
+P polygonCentroid(const P *points, size_t count) {
+    using T = ScalarOf<P>;
+    using Traits = PointTraits<P>;
+    if (count == 0) return Traits::make(T(0), T(0));
+
+    const T anchorX = Traits::x(points[0]);
+    const T anchorY = Traits::y(points[0]);
+    T totalArea = T(0);
+    T weightedX = T(0);
+    T weightedY = T(0);
+
+    // Площадь со знаком: для невыпуклых многоугольников (звёзд)
+    // треугольники веера частично вычитаются.
+    for (size_t i = 1; i + 1 < count; ++i) {
+        const T ax = Traits::x(points[i]) - anchorX;
+        const T ay = Traits::y(points[i]) - anchorY;
+        const T bx = Traits::x(points[i + 1]) - anchorX;
+        const T by = Traits::y(points[i + 1]) - anchorY;
+        const T area = T(0.5) * (ax * by - ay * bx);
+        weightedX += area * (ax + bx) / T(3);
+        weightedY += area * (ay + by) / T(3);
+        totalArea += area;
+    }
+
+    if (std::abs(totalArea) > T(1e-10)) {
+        return Traits::make(anchorX + weightedX / totalArea, anchorY + weightedY / totalArea);
+    }
+
+    T sumX = T(0);
+    T sumY = T(0);
+    for (size_t i = 0; i < count; ++i) {
+        sumX += Traits::x(points[i]);
+        sumY += Traits::y(points[i]);
+    }
+    return Traits::make(sumX / static_cast<T>(count), sumY / static_cast<T>(count));
+}
+
+#define GEOMETRYCORE_INSTANTIATE(P)                                                        \
+    template P rotatedPoint<P>(const P &, ScalarOf<P>, ScalarOf<P>, ScalarOf<P>);          \
+    template P scaledPoint<P>(const P &, ScalarOf<P>, ScalarOf<P>, ScalarOf<P>);           \
+    template void rotatePoints<P>(P *, size_t, ScalarOf<P>, ScalarOf<P>, ScalarOf<P>);     \
+    template void scalePoints<P>(P *, size_t, ScalarOf<P>, ScalarOf<P>, ScalarOf<P>);      \
+    template ScalarOf<P> polygonArea<P>(const P *, size_t);                                \
+    template ScalarOf<P> polygonPerimeter<P>(const P *, size_t);                           \
+    template P polygonCentroid<P>(const P *, size_t);
+
+GEOMETRYCORE_INSTANTIATE(Point2<float>)
+GEOMETRYCORE_INSTANTIATE(Point2<double>)
+GEOMETRYCORE_INSTANTIATE(QPointF)
@@ -0,0 +1,96 @@
+#ifndef GEOMETRYCORE_H
+#define GEOMETRYCORE_H
+
+#include <QPointF>
+#include <cstddef>
+#include <vector>
+
+// Геометрическое ядро, параметризованное типом точки, а через него —
+// типом координат. Определения в geometrycore.cpp, явно
+// инстанцированы для Point2<float>, Point2<double> и QPointF.
+//
+// Интерфейс Shape остаётся на double и QPointF — это язык QPainter.
+// Хранить же вершины можно в float: BasicPolygon<float> держит их в
+// Point2<float> и считает площадь и преобразования этим ядром прямо
+// над ними; для готовых контуров есть convertPoints.
+
+template <typename T>
+struct Point2 {
+    T x;
+    T y;
+};
+
+template <typename P>
+struct PointTraits;
+
+template <typename T>
+struct PointTraits<Point2<T>> {
+    using Scalar = T;
+    static T x(const Point2<T> &p) { return p.x; }
+    static T y(const Point2<T> &p) { return p.y; }
+    static Point2<T> make(T x, T y) { return Point2<T>{x, y}; }
+};
+
+template <>
+struct PointTraits<QPointF> {
+    using Scalar = double;
+    static double x(const QPointF &p) { return p.x(); }
+    static double y(const QPointF &p) { return p.y(); }
+    static QPointF make(double x, double y) { return QPointF(x, y); }
+};
+
+template <typename P>
+using ScalarOf = typename PointTraits<P>::Scalar;
+
+// Поворот против часовой стрелки (в осях с y вверх) вокруг (originX, originY)
+template <typename P>
+P rotatedPoint(const P &point, ScalarOf<P> angleDeg, ScalarOf<P> originX, ScalarOf<P> originY);
+
+template <typename P>
+P scaledPoint(const P &point, ScalarOf<P> factor, ScalarOf<P> originX, ScalarOf<P> originY);
+
+// Пакетные варианты: синус и косинус считаются один раз
+template <typename P>
+void rotatePoints(P *points, size_t count, ScalarOf<P> angleDeg, ScalarOf<P> originX, ScalarOf<P> originY);
+
+template <typename P>
+void scalePoints(P *points, size_t count, ScalarOf<P> factor, ScalarOf<P> originX, ScalarOf<P> originY);
+
+// Площадь (без знака) и периметр замкнутой ломаной; меньше 3 точек — 0
+template <typename P>
+ScalarOf<P> polygonArea(const P *points, size_t count);
+
+template <typename P>
+ScalarOf<P> polygonPerimeter(const P *points, size_t count);
+
+// Центр масс по треугольникам веера; при нулевой площади — среднее вершин
+template <typename P>
+P polygonCentroid(const P *points, size_t count);
+
+template <typename To, typename From>
+std::vector<To> convertPoints(const std::vector<From> &points) {
+    std::vector<To> result;
+    result.reserve(points.size());
+    for (const From &p : points) {
+        result.push_back(PointTraits<To>::make(static_cast<ScalarOf<To>>(PointTraits<From>::x(p)),
+                                               static_cast<ScalarOf<To>>(PointTraits<From>::y(p))));
+    }
+    return result;
+}
+
+#define GEOMETRYCORE_DECLARE(P)                                                                   \
+    extern template P rotatedPoint<P>(const P &, ScalarOf<P>, ScalarOf<P>, ScalarOf<P>);          \
+    extern template P scaledPoint<P>(const P &, ScalarOf<P>, ScalarOf<P>, ScalarOf<P>);           \
+    extern template void rotatePoints<P>(P *, size_t, ScalarOf<P>, ScalarOf<P>, ScalarOf<P>);     \
+    extern template void scalePoints<P>(P *, size_t, ScalarOf<P>, ScalarOf<P>, ScalarOf<P>);      \
+    extern template ScalarOf<P> polygonArea<P>(const P *, size_t);                                \
+    extern template ScalarOf<P> polygonPerimeter<P>(const P *, size_t);                           \
+    extern template P polygonCentroid<P>(const P *, size_t);
+
+GEOMETRYCORE_DECLARE(Point2<float>)
+GEOMETRYCORE_DECLARE(Point2<double>)
+GEOMETRYCORE_DECLARE(QPointF)
+
+#undef GEOMETRYCORE_DECLARE
+
+#endif // GEOMETRYCORE_H
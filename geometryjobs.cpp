@@ -0,0 +1,141 @@
+#include "geometryjobs.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+// Вершин между проверками отмены
+static const size_t kChunkVertices = 1 << 16;
+
+void JobContext::report(double fraction) {
+    if (!progress) return;
+
+    fraction = std::min(std::max(fraction, 0.0), 1.0);
+    if (fraction < 1.0 && fraction - lastReported < 0.01) return;
+
+    lastReported = fraction;
+    progress(fraction);
+}
+
+// Обходит рёбра (v[i], v[i+1]) блоками, между блоками проверяет отмену
+template <typename EdgeFunction>
+static void forEachEdge(const std::vector<QPointF> &verts, JobContext &context, EdgeFunction &&fn) {
+    const size_t n = verts.size();
+
+    for (size_t begin = 0; begin < n; begin += kChunkVertices) {
+        context.throwIfCancelled();
+
+        size_t end = std::min(n, begin + kChunkVertices);
+        for (size_t i = begin; i < end; ++i) {
+            fn(verts[i], verts[(i + 1) % n]);
+        }
+
+        context.report(static_cast<double>(end) / n);
+    }
+}
+
+AsyncJob<double> polygonAreaAsync(std::shared_ptr<const Polygon> polygon, ProgressCallback progress) {
+    // Константные методы многоугольника только читают, поэтому
+    // вершины можно снять в рабочем потоке
+    return runAsync([polygon](JobContext &context) {
+        const std::vector<QPointF> verts = polygon->getVertices();
+        double twiceArea = 0.0;
+        forEachEdge(verts, context, [&](const QPointF &a, const QPointF &b) {
+            twiceArea += a.x() * b.y() - b.x() * a.y();
+        });
+        return std::abs(twiceArea) * 0.5;
+    }, std::move(progress));
+}
+
+AsyncJob<QPointF> polygonCentroidAsync(std::shared_ptr<const Polygon> polygon, ProgressCallback progress) {
+    return runAsync([polygon](JobContext &context) {
+        const std::vector<QPointF> verts = polygon->getVertices();
+
+        // Относительно первой вершины, чтобы не терять точность вдали от нуля
+        const QPointF origin = verts.front();
+        double twiceArea = 0.0;
+        double sumX = 0.0;
+        double sumY = 0.0;
+
+        forEachEdge(verts, context, [&](const QPointF &a, const QPointF &b) {
+            double ax = a.x() - origin.x();
+            double ay = a.y() - origin.y();
+            double bx = b.x() - origin.x();
+            double by = b.y() - origin.y();
+            double cross = ax * by - bx * ay;
+
+            twiceArea += cross;
+            sumX += (ax + bx) * cross;
+            sumY += (ay + by) * cross;
+        });
+
+        if (std::abs(twiceArea) > 1e-10) {
+            return QPointF(origin.x() + sumX / (3.0 * twiceArea),
+                           origin.y() + sumY / (3.0 * twiceArea));
+        }
+
+        double avgX = 0.0;
+        double avgY = 0.0;
+        for (const QPointF &v : verts) {
+            avgX += v.x();
+            avgY += v.y();
+        }
+        return QPointF(avgX / verts.size(), avgY / verts.size());
+    }, std::move(progress));
+}
+
+AsyncJob<std::unique_ptr<Heart>> heartWithResolutionAsync(const Heart &heart, int resolution,
+                                                          ProgressCallback progress) {
+    if (resolution < 3) {
+        throw std::invalid_argument("Разрешение сердца должно быть >= 3. Передано: " + std::to_string(resolution));
+    }
+
+    std::shared_ptr<const Heart> source(new Heart(heart));
+    source->materialize();
+
+    return runAsync([source, resolution](JobContext &context) {
+        auto result = std::make_unique<Heart>(*source);
+        result->setResolution(resolution);
+        result->materialize();
+        context.report(1.0);
+        return result;
+    }, std::move(progress));
+}
+
+AsyncJob<void> transformSceneAsync(SceneStore &store, std::function<void(Shape&)> fn,
+                                   ProgressCallback progress) {
+    return runAsync([&store, fn = std::move(fn)](JobContext &context) {
+        // Копии строятся по версии, взятой без блокировки редактора,
+        // поэтому GUI и другие редакторы задачу не ждут
+        const std::shared_ptr<const SceneSnapshot> base = store.read().retain();
+        const size_t count = base->size();
+
+        std::vector<std::unique_ptr<Shape>> edited(count);
+        for (size_t i = 0; i < count; ++i) {
+            if ((i & 63) == 0) {
+                context.throwIfCancelled();
+                context.report(static_cast<double>(i) / count);
+            }
+            edited[i] = base->at(i).clone();
+            fn(*edited[i]);
+            edited[i]->materialize();
+        }
+
+        context.throwIfCancelled();
+
+        // Блокировка — только на публикацию. Фигуры, которые другой
+        // редактор успел заменить или добавить после base, обрабатываются
+        // заново поверх его версии, чтобы его правки не потерялись.
+        // Фигуры base живы, пока жива base, так что совпадение адресов
+        // означает, что фигура не менялась
+        SceneStore::Transaction transaction(store);
+        for (size_t i = 0; i < transaction.size(); ++i) {
+            if (i < count && &transaction.at(i) == &base->at(i)) {
+                transaction.replace(i, std::move(edited[i]));
+            } else {
+                transaction.edit(i, fn);
+            }
+        }
+        transaction.commit();
+        context.report(1.0);
+    }, std::move(progress));
+}
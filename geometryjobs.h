@@ -0,0 +1,109 @@
+#ifndef GEOMETRYJOBS_H
+#define GEOMETRYJOBS_H
+
+#include "heart.h"
+#include "polygon.h"
+#include "scenestore.h"
+#include "threadpool.h"
+#include <atomic>
+#include <functional>
+#include <future>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+// Асинхронный запуск долгих геометрических операций на общем пуле.
+// Результат приходит через std::future; отменённая задача завершается
+// исключением JobCancelled. Колбэк прогресса вызывается в рабочем потоке,
+// поэтому GUI должен переслать значение в свой поток (например, через
+// QMetaObject::invokeMethod с Qt::QueuedConnection).
+
+class JobCancelled : public std::runtime_error {
+public:
+    JobCancelled() : std::runtime_error("Задача отменена") {}
+};
+
+class CancellationToken {
+private:
+    std::shared_ptr<std::atomic<bool>> flag;
+
+public:
+    CancellationToken() : flag(std::make_shared<std::atomic<bool>>(false)) {}
+
+    void cancel() { flag->store(true); }
+    bool isCancelled() const { return flag->load(std::memory_order_relaxed); }
+};
+
+// Прогресс от 0 до 1
+using ProgressCallback = std::function<void(double)>;
+
+// Передаётся в тело задачи для проверки отмены и отчёта о прогрессе
+class JobContext {
+private:
+    CancellationToken token;
+    ProgressCallback progress;
+    double lastReported = -1.0;
+
+public:
+    JobContext(const CancellationToken &cancellation, ProgressCallback callback)
+        : token(cancellation), progress(std::move(callback)) {}
+
+    bool isCancelled() const { return token.isCancelled(); }
+
+    void throwIfCancelled() const {
+        if (token.isCancelled()) throw JobCancelled();
+    }
+
+    // Колбэк вызывается не чаще, чем на каждый процент
+    void report(double fraction);
+};
+
+template <typename Result>
+struct AsyncJob {
+    std::future<Result> result;
+    CancellationToken token;
+
+    void cancel() { token.cancel(); }
+    Result get() { return result.get(); }
+};
+
+template <typename Function>
+auto runAsync(Function fn, ProgressCallback progress = ProgressCallback(),
+              ThreadPool &pool = ThreadPool::shared())
+    -> AsyncJob<decltype(fn(std::declval<JobContext&>()))>
+{
+    using Result = decltype(fn(std::declval<JobContext&>()));
+
+    AsyncJob<Result> job;
+    auto context = std::make_shared<JobContext>(job.token, std::move(progress));
+    auto task = std::make_shared<std::packaged_task<Result()>>(
+        [fn = std::move(fn), context]() mutable {
+            context->throwIfCancelled();
+            return fn(*context);
+        });
+
+    job.result = task->get_future();
+    pool.submit([task]() { (*task)(); });
+    return job;
+}
+
+// Площадь и центр масс по формуле шнурования, блоками с проверкой отмены.
+// Многоугольник не должен изменяться, пока задача выполняется.
+AsyncJob<double> polygonAreaAsync(std::shared_ptr<const Polygon> polygon,
+                                  ProgressCallback progress = ProgressCallback());
+AsyncJob<QPointF> polygonCentroidAsync(std::shared_ptr<const Polygon> polygon,
+                                       ProgressCallback progress = ProgressCallback());
+
+// Копия сердца с новым разрешением; исходная фигура не меняется
+AsyncJob<std::unique_ptr<Heart>> heartWithResolutionAsync(const Heart &heart, int resolution,
+                                                          ProgressCallback progress = ProgressCallback());
+
+// Применяет fn ко всем фигурам сцены одной транзакцией. При отмене
+// новая версия не публикуется и сцена остаётся прежней. Фигуры
+// копируются и изменяются без блокировки редактора; она берётся только
+// на публикацию, а фигуры, изменённые за это время другими
+// редакторами, обрабатываются заново поверх их правок.
+AsyncJob<void> transformSceneAsync(SceneStore &store, std::function<void(Shape&)> fn,
+                                   ProgressCallback progress = ProgressCallback());
+
+#endif // GEOMETRYJOBS_H
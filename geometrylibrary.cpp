@@ -0,0 +1,164 @@
+#include "geometrylibrary.h"
+#include "geometrycore.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+GeometryLibrary::GeometryLibrary(double tolerance) : tolerance(tolerance) {
+    if (!(tolerance > 0.0)) {
+        throw std::invalid_argument("Точность сравнения форм должна быть положительной. Передано: " +
+                                    std::to_string(tolerance));
+    }
+}
+
+// Контур в каноническом положении и преобразование из него обратно
+static std::vector<QPointF> canonicalize(std::vector<QPointF> points, double tolerance, Transform2D &placement) {
+    if (points.size() > 1 && points.front() == points.back()) points.pop_back();
+    if (points.size() < 3) {
+        throw std::invalid_argument(
+            "Контур формы должен иметь минимум 3 вершины. Передано: " + std::to_string(points.size())
+            );
+    }
+
+    double signedArea = 0.0;
+    for (size_t i = 1; i + 1 < points.size(); ++i) {
+        const QPointF a = points[i] - points[0];
+        const QPointF b = points[i + 1] - points[0];
+        signedArea += a.x() * b.y() - a.y() * b.x();
+    }
+    if (signedArea < 0.0) std::reverse(points.begin(), points.end());
+
+    const QPointF center = polygonCentroid(points.data(), points.size());
+
+    double maxDistance2 = 0.0;
+    std::vector<double> distance2(points.size());
+    for (size_t i = 0; i < points.size(); ++i) {
+        const QPointF d = points[i] - center;
+        distance2[i] = d.x() * d.x() + d.y() * d.y();
+        maxDistance2 = std::max(maxDistance2, distance2[i]);
+    }
+
+    if (!(maxDistance2 > 0.0) || signedArea == 0.0) {
+        throw std::invalid_argument("Контур формы вырожден: нулевая площадь");
+    }
+
+    const double radius = std::sqrt(maxDistance2);
+    const double tieLimit = maxDistance2 * (1.0 - tolerance) * (1.0 - tolerance);
+
+    // Самых далёких вершин может быть несколько (правильные многоугольники,
+    // симметричные фигуры); из вариантов берётся лексикографически
+    // наименьший, чтобы выбор не зависел от того, с какой вершины начат контур
+    auto quantized = [tolerance](double value) { return std::llround(value / tolerance); };
+    auto less = [&](const std::vector<QPointF> &l, const std::vector<QPointF> &r) {
+        for (size_t i = 0; i < l.size(); ++i) {
+            if (quantized(l[i].x()) != quantized(r[i].x())) return quantized(l[i].x()) < quantized(r[i].x());
+            if (quantized(l[i].y()) != quantized(r[i].y())) return quantized(l[i].y()) < quantized(r[i].y());
+        }
+        return false;
+    };
+
+    std::vector<QPointF> best;
+    std::vector<QPointF> candidate(points.size());
+    double bestAngle = 0.0;
+    for (size_t start = 0; start < points.size(); ++start) {
+        if (distance2[start] < tieLimit) continue;
+
+        const QPointF direction = points[start] - center;
+        const double angle = std::atan2(direction.y(), direction.x());
+        const double cosA = std::cos(angle) / radius;
+        const double sinA = std::sin(angle) / radius;
+        for (size_t i = 0; i < points.size(); ++i) {
+            const QPointF d = points[(start + i) % points.size()] - center;
+            candidate[i] = QPointF(d.x() * cosA + d.y() * sinA, -d.x() * sinA + d.y() * cosA);
+        }
+
+        if (best.empty() || less(candidate, best)) {
+            best = candidate;
+            bestAngle = angle;
+        }
+    }
+
+    placement = Transform2D(bestAngle * 180.0 / M_PI, radius, center.x(), center.y());
+    return best;
+}
+
+uint64_t GeometryLibrary::hashOf(const std::vector<QPointF> &canonical) const {
+    // FNV-1a по числу вершин и координатам, округлённым до tolerance
+    uint64_t hash = 1469598103934665603ull;
+    auto mix = [&hash](uint64_t value) {
+        for (int byte = 0; byte < 8; ++byte) {
+            hash ^= (value >> (8 * byte)) & 0xffu;
+            hash *= 1099511628211ull;
+        }
+    };
+
+    mix(canonical.size());
+    for (const QPointF &p : canonical) {
+        mix(static_cast<uint64_t>(std::llround(p.x() / tolerance)));
+        mix(static_cast<uint64_t>(std::llround(p.y() / tolerance)));
+    }
+    return hash;
+}
+
+// Сравнение по тем же округлённым координатам, что и hashOf: совпавшие
+// формы всегда попадают в одну корзину
+bool GeometryLibrary::matches(const std::vector<QPointF> &canonical, const CanonicalGeometry &geometry) const {
+    if (canonical.size() != geometry.vertices.size()) return false;
+    for (size_t i = 0; i < canonical.size(); ++i) {
+        if (std::llround(canonical[i].x() / tolerance) != std::llround(geometry.vertices[i].x() / tolerance) ||
+            std::llround(canonical[i].y() / tolerance) != std::llround(geometry.vertices[i].y() / tolerance)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+ShapeInstance GeometryLibrary::add(const Shape &shape) {
+    return intern(shape.outline(), &shape);
+}
+
+ShapeInstance GeometryLibrary::add(const std::vector<QPointF> &contour) {
+    return intern(contour, nullptr);
+}
+
+ShapeInstance GeometryLibrary::intern(const std::vector<QPointF> &contour, const Shape *source) {
+    ShapeInstance instance;
+    std::vector<QPointF> canonical = canonicalize(contour, tolerance, instance.placement);
+    const uint64_t hash = hashOf(canonical);
+
+    std::vector<size_t> &bucket = byHash[hash];
+    for (size_t index : bucket) {
+        if (matches(canonical, geometries[index])) {
+            instance.geometry = index;
+            return instance;
+        }
+    }
+
+    CanonicalGeometry geometry;
+    geometry.hash = hash;
+    // У фигуры с точной формулой (круг, сердце) площадь и периметр
+    // берутся из неё, а не из ломаной контура
+    const double scale = instance.placement.scale();
+    geometry.area = source ? source->area() / (scale * scale) : polygonArea(canonical.data(), canonical.size());
+    geometry.perimeter = source ? source->perimeter() / scale : polygonPerimeter(canonical.data(), canonical.size());
+    geometry.vertices = std::move(canonical);
+
+    instance.geometry = geometries.size();
+    bucket.push_back(instance.geometry);
+    geometries.push_back(std::move(geometry));
+    return instance;
+}
+
+double GeometryLibrary::area(const ShapeInstance &instance) const {
+    const double scale = instance.placement.scale();
+    return geometries[instance.geometry].area * scale * scale;
+}
+
+double GeometryLibrary::perimeter(const ShapeInstance &instance) const {
+    return geometries[instance.geometry].perimeter * instance.placement.scale();
+}
+
+std::unique_ptr<Polygon> GeometryLibrary::instantiate(const ShapeInstance &instance) const {
+    return std::make_unique<Polygon>(geometries[instance.geometry].vertices, instance.placement);
+}
@@ -0,0 +1,68 @@
+#ifndef GEOMETRYLIBRARY_H
+#define GEOMETRYLIBRARY_H
+
+#include "polygon.h"
+#include "sharedvertices.h"
+#include "transform2d.h"
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+// Форма фигуры без положения, поворота и размера: центр масс в начале
+// координат, самая далёкая от центра вершина — первая и лежит на оси +x
+// на расстоянии 1, обход положительный.
+struct CanonicalGeometry {
+    SharedVertices vertices;
+    uint64_t hash = 0;
+    // При единичном масштабе; для добавленной фигуры — её area() и
+    // perimeter(), приведённые к единичному масштабу
+    double area = 0.0;
+    double perimeter = 0.0;
+};
+
+// Фигура сцены как ссылка на общую форму и её размещение:
+// точка p формы переходит в placement.map(p)
+struct ShapeInstance {
+    size_t geometry = 0;
+    Transform2D placement;
+};
+
+// Хранилище уникальных форм. Конгруэнтные (совпадающие после переноса,
+// поворота и равномерного масштаба) контуры сводятся к одной форме,
+// так что площадь, триангуляцию и кэши отрисовки можно считать один
+// раз на форму, по индексу ShapeInstance::geometry.
+//
+// Координаты канонической формы (радиус 1) округляются до сетки с
+// шагом tolerance; формы совпадают, если совпали все округлённые
+// координаты — по ним же считается хэш. Зеркальные отражения
+// считаются разными формами.
+class GeometryLibrary {
+private:
+    double tolerance;
+    std::vector<CanonicalGeometry> geometries;
+    std::unordered_map<uint64_t, std::vector<size_t>> byHash;
+
+    uint64_t hashOf(const std::vector<QPointF> &canonical) const;
+    bool matches(const std::vector<QPointF> &canonical, const CanonicalGeometry &geometry) const;
+    ShapeInstance intern(const std::vector<QPointF> &contour, const Shape *source);
+
+public:
+    explicit GeometryLibrary(double tolerance = 1e-6);
+
+    // Контур фигуры (outline()) как экземпляр формы; новая форма
+    // добавляется, если похожей ещё нет
+    ShapeInstance add(const Shape &shape);
+    ShapeInstance add(const std::vector<QPointF> &contour);
+
+    size_t geometryCount() const { return geometries.size(); }
+    const CanonicalGeometry &geometry(size_t index) const { return geometries[index]; }
+
+    double area(const ShapeInstance &instance) const;
+    double perimeter(const ShapeInstance &instance) const;
+
+    // Многоугольник, разделяющий вершины с формой
+    std::unique_ptr<Polygon> instantiate(const ShapeInstance &instance) const;
+};
+
+#endif // GEOMETRYLIBRARY_H
@@ -1,4 +1,5 @@
 #include "heart.h"
+#include "instrumentation.h"
 #include <cmath>
 #include <stdexcept>
 #include <QDebug>
@@ -55,69 +56,83 @@ Heart::Heart(double x, double y, double s, int res)
     vertices = generateHeartVertices(x, y, s, res);
 }
 
-double Heart::calculateArea() const {
-    if (vertices.size() < 3) return 0.0;
-
-    double totalArea = 0.0;
-    size_t n = vertices.size();
-
-    for (size_t i = 0; i < n; ++i) {
-        size_t j = (i + 1) % n;
-
-        const QPointF &v0 = QPointF(centerX, centerY);
-        const QPointF &v1 = vertices[i];
-        const QPointF &v2 = vertices[j];
-
-        double area = 0.5 * std::abs(
-                          (v1.x() - v0.x()) * (v2.y() - v0.y()) -
-                          (v2.x() - v0.x()) * (v1.y() - v0.y())
-                          );
+std::vector<QPointF> Heart::getVertices() const {
+    return outline();
+}
 
-        totalArea += area;
+// Кривая сердца в параметрических единицах:
+// x(t) = 16 sin³t, y(t) = 13 cos t − 5 cos 2t − 2 cos 3t − cos 4t.
+// Вершины — это точки кривой, умноженные на size / 17, поэтому площадь
+// и периметр зависят только от size, а не от разрешения.
+
+// ∮ x dy по ортогональности тригонометрических рядов даёт ровно 180π
+static const double kUnitHeartArea = 180.0 * M_PI;
+
+// Длина кривой в параметрических единицах. Интеграл скорости не берётся
+// в элементарных функциях, поэтому считается один раз составной
+// квадратурой Гаусса–Лежандра. Точки возврата t = 0 и t = π попадают на
+// границы отрезков, внутри которых скорость гладкая.
+static double unitHeartPerimeter() {
+    static const double nodes[] = {
+        0.1834346424956498, 0.5255324099163290, 0.7966664774136267, 0.9602898564975363
+    };
+    static const double weights[] = {
+        0.3626837833783620, 0.3137066458778873, 0.2223810344533745, 0.1012285362903763
+    };
+    const int panels = 64;
+    const double h = 2.0 * M_PI / panels;
+
+    auto speed = [](double t) {
+        double dx = 48.0 * std::sin(t) * std::sin(t) * std::cos(t);
+        double dy = -13.0 * std::sin(t) + 10.0 * std::sin(2.0 * t)
+                    + 6.0 * std::sin(3.0 * t) + 4.0 * std::sin(4.0 * t);
+        return std::sqrt(dx * dx + dy * dy);
+    };
+
+    double length = 0.0;
+    for (int p = 0; p < panels; ++p) {
+        double mid = (p + 0.5) * h;
+        for (int k = 0; k < 4; ++k) {
+            double offset = 0.5 * h * nodes[k];
+            length += weights[k] * (speed(mid - offset) + speed(mid + offset));
+        }
     }
+    return 0.5 * h * length;
+}
 
-    return totalArea;
+double Heart::calculateArea() const {
+    SHAPE_PROBE_SHAPE(Area);
+    const double scale = size / 17.0;
+    return kUnitHeartArea * scale * scale;
 }
 
 double Heart::calculatePerimeter() const {
-    if (vertices.size() < 2) return 0.0;
-
-    double perimeter = 0.0;
-    size_t n = vertices.size();
-
-    for (size_t i = 0; i < n; ++i) {
-        size_t j = (i + 1) % n;
-        double dx = vertices[j].x() - vertices[i].x();
-        double dy = vertices[j].y() - vertices[i].y();
-        perimeter += std::sqrt(dx * dx + dy * dy);
-    }
-
-    return perimeter;
+    SHAPE_PROBE_SHAPE(Perimeter);
+    static const double unitPerimeter = unitHeartPerimeter();
+    return unitPerimeter * size / 17.0;
 }
 
 void Heart::move(double dx, double dy) {
+    SHAPE_PROBE_SHAPE(Move);
     centerX += dx;
     centerY += dy;
 
-    for (QPointF &v : vertices) {
-        v.rx() += dx;
-        v.ry() += dy;
-    }
+    pending.translate(dx, dy);
 }
 
 void Heart::rotate(double angleDeg, double originX, double originY) {
+    SHAPE_PROBE_SHAPE(Rotate);
     if (std::abs(angleDeg) < 1e-6) return;
 
     QPointF newCenter = rotatePoint(QPointF(centerX, centerY), angleDeg, originX, originY);
     centerX = newCenter.x();
     centerY = newCenter.y();
 
-    for (QPointF &v : vertices) {
-        v = rotatePoint(v, angleDeg, originX, originY);
-    }
+    pending.rotate(angleDeg, originX, originY);
 }
 
 void Heart::scale(double factor, double originX, double originY) {
+    SHAPE_PROBE_SHAPE(Scale);
     if (std::abs(factor - 1.0) < 1e-6) return;
 
     if (factor <= 0.0) {
@@ -131,22 +146,24 @@ void Heart::scale(double factor, double originX, double originY) {
     centerX = newCenter.x();
     centerY = newCenter.y();
 
-    for (QPointF &v : vertices) {
-        v = scalePoint(v, factor, originX, originY);
-    }
+    pending.scale(factor, originX, originY);
 
     size *= factor;
 }
 
 void Heart::draw(QPainter &painter) const {
+    SHAPE_PROBE_SHAPE(Draw);
     painter.setRenderHint(QPainter::Antialiasing, true);
 
     QPainterPath path;
 
-    if (!vertices.empty()) {
-        path.moveTo(vertices[0]);
-        for (size_t i = 1; i < vertices.size(); ++i) {
-            path.lineTo(vertices[i]);
+    // Вершины преобразуются во временную копию, общий буфер не меняется
+    const std::vector<QPointF> points = outline();
+
+    if (!points.empty()) {
+        path.moveTo(points[0]);
+        for (size_t i = 1; i < points.size(); ++i) {
+            path.lineTo(points[i]);
         }
         path.closeSubpath();
     }
@@ -161,6 +178,18 @@ void Heart::draw(QPainter &painter) const {
     painter.drawEllipse(QPointF(centerX, centerY), 4, 4);
 }
 
+QRectF Heart::boundingRect() const {
+    return pending.mapBounds(vertices.get());
+}
+
+std::vector<QPointF> Heart::outline() const {
+    return pending.mapped(vertices.get());
+}
+
+void Heart::signedDistances(const double *xs, const double *ys, double *out, size_t count) const {
+    signedDistancesToPolygon(outline(), xs, ys, out, count);
+}
+
 void Heart::setSize(double s) {
     if (s <= 0.0) {
         throw std::invalid_argument("Размер сердца должен быть положительным. Передано: " + std::to_string(s));
@@ -177,4 +206,5 @@ void Heart::setResolution(int res) {
 
     resolution = res;
     vertices = generateHeartVertices(centerX, centerY, size, res);
+    pending = Transform2D();
 }
@@ -2,6 +2,8 @@
 #define HEART_H
 
 #include "shape.h"
+#include "sharedvertices.h"
+#include "transform2d.h"
 #include <vector>
 
 
@@ -9,7 +11,11 @@ class Heart : public Shape {
 private:
     double size;
     int resolution;
-    std::vector<QPointF> vertices;
+
+    // Вершины без отложенного преобразования pending, общие для копий;
+    // чтение отображает их через pending, не меняя буфер
+    SharedVertices vertices;
+    Transform2D pending;
 
     static std::vector<QPointF> generateHeartVertices(double x, double y, double s, int res);
 
@@ -28,6 +34,10 @@ public:
     void rotate(double angleDeg, double originX, double originY) override;
     void scale(double factor, double originX, double originY) override;
     void draw(QPainter &painter) const override;
+    QRectF boundingRect() const override;
+    std::vector<QPointF> outline() const override;
+    void signedDistances(const double *xs, const double *ys, double *out, size_t count) const override;
+    std::unique_ptr<Shape> clone() const override { return std::make_unique<Heart>(*this); }
 
     double getSize() const { return size; }
     void setSize(double s);
@@ -35,7 +45,7 @@ public:
     int getResolution() const { return resolution; }
     void setResolution(int res);
 
-    const std::vector<QPointF>& getVertices() const { return vertices; }
+    std::vector<QPointF> getVertices() const;
 };
 
 #endif // HEART_H
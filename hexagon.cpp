@@ -1,4 +1,6 @@
 #include "hexagon.h"
+#include "instrumentation.h"
+#include <algorithm>
 #include <cmath>
 #include <stdexcept>
 #include <QDebug>
@@ -55,23 +57,17 @@ Hexagon::Hexagon(double x, double y, double radius, bool useRadius)
     side = radius;
 }
 
-void Hexagon::updateSide() {
-    double sum = 0.0;
-    size_t n = vertexCount();
-
-    for (size_t i = 0; i < n; ++i) {
-        size_t j = (i + 1) % n;
-        const QPointF &v1 = vertex(i);
-        const QPointF &v2 = vertex(j);
-
-        double dx = v2.x() - v1.x();
-        double dy = v2.y() - v1.y();
-        double length = std::sqrt(dx * dx + dy * dy);
-
-        sum += length;
-    }
-
-    side = sum / n;
+void Hexagon::rebuildVertices() {
+    const double h = side * std::sqrt(3.0) * 0.5;
+    const QPointF local[6] = {
+        QPointF( side,        0.0),
+        QPointF( side * 0.5, -h),
+        QPointF(-side * 0.5, -h),
+        QPointF(-side,        0.0),
+        QPointF(-side * 0.5,  h),
+        QPointF( side * 0.5,  h)
+    };
+    setLocalFrame(local, 6, orientation);
 }
 
 void Hexagon::setSide(double s) {
@@ -87,15 +83,22 @@ void Hexagon::setSide(double s) {
 }
 
 void Hexagon::move(double dx, double dy) {
+    SHAPE_PROBE_SHAPE(Move);
     Polygon::move(dx, dy);
 }
 
 void Hexagon::rotate(double angleDeg, double originX, double originY) {
-    Polygon::rotate(angleDeg, originX, originY);
-    updateSide();
+    SHAPE_PROBE_SHAPE(Rotate);
+    QPointF newCenter = rotatePoint(QPointF(centerX, centerY), angleDeg, originX, originY);
+    centerX = newCenter.x();
+    centerY = newCenter.y();
+
+    orientation = std::fmod(orientation + angleDeg, 360.0);
+    rebuildVertices();
 }
 
 void Hexagon::scale(double factor, double originX, double originY) {
+    SHAPE_PROBE_SHAPE(Scale);
     if (factor <= 0.0) {
         throw std::invalid_argument(
             "Коэффициент масштабирования должен быть положительным. "
@@ -103,8 +106,12 @@ void Hexagon::scale(double factor, double originX, double originY) {
             );
     }
 
-    Polygon::scale(factor, originX, originY);
+    QPointF newCenter = scalePoint(QPointF(centerX, centerY), factor, originX, originY);
+    centerX = newCenter.x();
+    centerY = newCenter.y();
+
     side *= factor;
+    rebuildVertices();
 }
 
 double Hexagon::getVertexAngle(size_t vertexIndex) const {
@@ -175,3 +182,35 @@ bool Hexagon::hasEqualAngles(double tolerance) const {
 
     return true;
 }
+
+void Hexagon::signedDistances(const double *xs, const double *ys, double *out, size_t count) const {
+    const double angleRad = orientation * M_PI / 180.0;
+    const double cosA = std::cos(angleRad);
+    const double sinA = std::sin(angleRad);
+    const double h = side * std::sqrt(3.0) * 0.5;
+
+    for (size_t i = 0; i < count; ++i) {
+        double dx = xs[i] - centerX;
+        double dy = ys[i] - centerY;
+        double px = std::abs(dx * cosA + dy * sinA);
+        double py = std::abs(-dx * sinA + dy * cosA);
+
+        // Отражение относительно оси через вершину (side / 2, h) сводит
+        // первую четверть к сектору 0°–60° с одной стороной
+        if (px * h - py * side * 0.5 < 0.0) {
+            double k = 2.0 * (px * 0.5 + py * h / side);
+            double rx = k * 0.5 - px;
+            double ry = k * h / side - py;
+            px = rx;
+            py = ry;
+        }
+
+        // Сторона от (side, 0) до (side / 2, h)
+        double t = std::clamp(((side - px) * side * 0.5 + py * h) / (side * side), 0.0, 1.0);
+        double ex = px - side * (1.0 - 0.5 * t);
+        double ey = py - h * t;
+        double distance = std::sqrt(ex * ex + ey * ey);
+
+        out[i] = px * h + py * side * 0.5 - side * h > 0.0 ? distance : -distance;
+    }
+}
@@ -6,14 +6,21 @@
 class Hexagon : public Polygon {
 private:
     double side;
+    double orientation = 0.0;
 
-    void updateSide();
+    void rebuildVertices();
+
+protected:
+    bool verticesFollowParameters() const override { return true; }
 
 public:
     Hexagon(double x, double y, double s);
     Hexagon(double x, double y, double radius, bool useRadius);
 
+    std::unique_ptr<Shape> clone() const override { return std::make_unique<Hexagon>(*this); }
+
     double getSide() const { return side; }
+    double getOrientation() const { return orientation; }
     void setSide(double s);
 
     double getCircumradius() const { return side; }
@@ -22,6 +29,7 @@ public:
     void move(double dx, double dy) override;
     void rotate(double angleDeg, double originX, double originY) override;
     void scale(double factor, double originX, double originY) override;
+    void signedDistances(const double *xs, const double *ys, double *out, size_t count) const override;
 
     double area() const override { return (3.0 * std::sqrt(3.0) / 2.0) * side * side; }
     double perimeter() const override { return 6.0 * side; }
@@ -0,0 +1,308 @@
+#include "instrumentation.h"
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <mutex>
+#include <sstream>
+#include <unordered_map>
+#include <vector>
+#ifdef __GNUC__
+#include <cxxabi.h>
+#endif
+
+// Предел событий трассировки на поток
+static const size_t kMaxTraceEvents = 1 << 20;
+
+static int64_t nowNanoseconds() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Счётчик пишет только поток-владелец, поэтому хватает load + store
+static void addRelaxed(std::atomic<uint64_t> &counter, uint64_t value) {
+    counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+}
+
+std::string Instrumentation::typeName(const std::type_info &type) {
+#ifdef __GNUC__
+    int status = 0;
+    char *demangled = abi::__cxa_demangle(type.name(), nullptr, nullptr, &status);
+    if (status == 0 && demangled) {
+        std::string name(demangled);
+        std::free(demangled);
+        return name;
+    }
+#endif
+    return type.name();
+}
+
+struct AtomicStat {
+    std::atomic<uint64_t> calls{0};
+    std::atomic<uint64_t> nanoseconds{0};
+};
+
+using AtomicStatArray = std::array<AtomicStat, Instrumentation::OperationCount>;
+
+struct TraceEvent {
+    Instrumentation::Operation operation;
+    const std::type_info *type;
+    int64_t start;
+    int64_t duration;
+    uint32_t threadId;
+};
+
+struct Instrumentation::ThreadStats {
+    uint32_t threadId = 0;
+    int depth[OperationCount] = {};
+    AtomicStatArray totals;
+
+    // Защищает структуру byType и events от чтения снимка;
+    // поток-владелец ищет в byType без блокировки
+    std::mutex mutex;
+    std::unordered_map<const std::type_info*, AtomicStatArray> byType;
+    std::vector<TraceEvent> events;
+};
+
+struct Registry {
+    std::mutex mutex;
+    std::vector<Instrumentation::ThreadStats*> live;
+    uint32_t nextThreadId = 1;
+
+    // Итоги завершившихся потоков и снимок на момент reset()
+    Instrumentation::Snapshot retired;
+    Instrumentation::Snapshot baseline;
+    std::vector<TraceEvent> retiredEvents;
+
+    std::atomic<bool> tracing{false};
+    int64_t origin = nowNanoseconds();
+};
+
+// Не уничтожается: потоки могут завершаться после выхода из main()
+static Registry &registry() {
+    static Registry *instance = new Registry;
+    return *instance;
+}
+
+static void accumulate(Instrumentation::StatArray &target, const AtomicStatArray &source) {
+    for (size_t i = 0; i < target.size(); ++i) {
+        target[i].calls += source[i].calls.load(std::memory_order_relaxed);
+        target[i].nanoseconds += source[i].nanoseconds.load(std::memory_order_relaxed);
+    }
+}
+
+// Вызывается под блокировкой реестра и stats.mutex
+static void collect(const Instrumentation::ThreadStats &stats, Instrumentation::Snapshot &target) {
+    accumulate(target.totals, stats.totals);
+    for (const auto &entry : stats.byType) {
+        accumulate(target.byType[Instrumentation::typeName(*entry.first)], entry.second);
+    }
+}
+
+// Регистрирует счётчики потока и переносит их в итоги при его завершении
+struct ThreadHandle {
+    Instrumentation::ThreadStats *stats;
+
+    ThreadHandle() : stats(new Instrumentation::ThreadStats) {
+        Registry &reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        stats->threadId = reg.nextThreadId++;
+        reg.live.push_back(stats);
+    }
+
+    ~ThreadHandle() {
+        Registry &reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        {
+            std::lock_guard<std::mutex> statsLock(stats->mutex);
+            collect(*stats, reg.retired);
+            reg.retiredEvents.insert(reg.retiredEvents.end(), stats->events.begin(), stats->events.end());
+        }
+        for (size_t i = 0; i < reg.live.size(); ++i) {
+            if (reg.live[i] == stats) {
+                reg.live.erase(reg.live.begin() + static_cast<std::ptrdiff_t>(i));
+                break;
+            }
+        }
+        delete stats;
+    }
+};
+
+static Instrumentation::ThreadStats &localStats() {
+    thread_local ThreadHandle handle;
+    return *handle.stats;
+}
+
+const char *Instrumentation::operationName(Operation operation) {
+    switch (operation) {
+    case Move: return "move";
+    case Rotate: return "rotate";
+    case Scale: return "scale";
+    case Area: return "area";
+    case Perimeter: return "perimeter";
+    case Draw: return "draw";
+    case SetVertex: return "setVertex";
+    case RotatePoint: return "rotatePoint";
+    case ScalePoint: return "scalePoint";
+    case CenterOfMass: return "calculateCenterOfMass";
+    default: return "?";
+    }
+}
+
+Instrumentation::Probe::Probe(Operation op, const std::type_info *shapeType)
+    : stats(&localStats()), operation(op), outermost(stats->depth[op]++ == 0),
+      type(shapeType), start(outermost ? nowNanoseconds() : 0)
+{
+}
+
+Instrumentation::Probe::~Probe() {
+    --stats->depth[operation];
+    if (!outermost) return;
+
+    int64_t duration = nowNanoseconds() - start;
+
+    addRelaxed(stats->totals[operation].calls, 1);
+    addRelaxed(stats->totals[operation].nanoseconds, static_cast<uint64_t>(duration));
+
+    if (type) {
+        auto found = stats->byType.find(type);
+        if (found == stats->byType.end()) {
+            std::lock_guard<std::mutex> lock(stats->mutex);
+            found = stats->byType.emplace(std::piecewise_construct,
+                                          std::forward_as_tuple(type), std::forward_as_tuple()).first;
+        }
+        addRelaxed(found->second[operation].calls, 1);
+        addRelaxed(found->second[operation].nanoseconds, static_cast<uint64_t>(duration));
+    }
+
+    if (registry().tracing.load(std::memory_order_relaxed)) {
+        std::lock_guard<std::mutex> lock(stats->mutex);
+        if (stats->events.size() < kMaxTraceEvents) {
+            stats->events.push_back({operation, type, start, duration, stats->threadId});
+        }
+    }
+}
+
+static Instrumentation::Snapshot rawSnapshot() {
+    Registry &reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+
+    Instrumentation::Snapshot result = reg.retired;
+    for (Instrumentation::ThreadStats *stats : reg.live) {
+        std::lock_guard<std::mutex> statsLock(stats->mutex);
+        collect(*stats, result);
+    }
+    return result;
+}
+
+static void subtract(Instrumentation::StatArray &target, const Instrumentation::StatArray &base) {
+    for (size_t i = 0; i < target.size(); ++i) {
+        target[i].calls -= std::min(target[i].calls, base[i].calls);
+        target[i].nanoseconds -= std::min(target[i].nanoseconds, base[i].nanoseconds);
+    }
+}
+
+Instrumentation::Snapshot Instrumentation::snapshot() {
+    Snapshot result = rawSnapshot();
+
+    Registry &reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    subtract(result.totals, reg.baseline.totals);
+    for (auto &entry : result.byType) {
+        auto base = reg.baseline.byType.find(entry.first);
+        if (base != reg.baseline.byType.end()) {
+            subtract(entry.second, base->second);
+        }
+    }
+    return result;
+}
+
+void Instrumentation::reset() {
+    Snapshot current = rawSnapshot();
+
+    Registry &reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    reg.baseline = current;
+    reg.retiredEvents.clear();
+    for (ThreadStats *stats : reg.live) {
+        std::lock_guard<std::mutex> statsLock(stats->mutex);
+        stats->events.clear();
+    }
+}
+
+std::string Instrumentation::format(const Snapshot &snapshot) {
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(3);
+
+    auto writeRows = [&out](const StatArray &stats, const std::string &indent) {
+        for (size_t i = 0; i < stats.size(); ++i) {
+            if (stats[i].calls == 0) continue;
+            double totalMs = stats[i].nanoseconds / 1e6;
+            double averageUs = stats[i].nanoseconds / 1e3 / stats[i].calls;
+            out << indent << std::left << std::setw(24) << operationName(static_cast<Operation>(i))
+                << std::right << std::setw(12) << stats[i].calls
+                << std::setw(14) << totalMs << " ms"
+                << std::setw(12) << averageUs << " us\n";
+        }
+    };
+
+    writeRows(snapshot.totals, "");
+    for (const auto &entry : snapshot.byType) {
+        out << entry.first << ":\n";
+        writeRows(entry.second, "  ");
+    }
+    return out.str();
+}
+
+void Instrumentation::setTracing(bool enabled) {
+    registry().tracing.store(enabled);
+}
+
+bool Instrumentation::isTracing() {
+    return registry().tracing.load();
+}
+
+bool Instrumentation::writeChromeTrace(const std::string &path) {
+    std::vector<TraceEvent> events;
+    int64_t origin;
+    {
+        Registry &reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        origin = reg.origin;
+        events = reg.retiredEvents;
+        for (ThreadStats *stats : reg.live) {
+            std::lock_guard<std::mutex> statsLock(stats->mutex);
+            events.insert(events.end(), stats->events.begin(), stats->events.end());
+        }
+    }
+
+    std::ofstream file(path);
+    if (!file) return false;
+
+    std::unordered_map<const std::type_info*, std::string> names;
+
+    file << std::fixed << std::setprecision(3);
+    file << "{\"traceEvents\":[";
+    for (size_t i = 0; i < events.size(); ++i) {
+        const TraceEvent &event = events[i];
+
+        std::string name = operationName(event.operation);
+        if (event.type) {
+            auto found = names.find(event.type);
+            if (found == names.end()) {
+                found = names.emplace(event.type, typeName(*event.type)).first;
+            }
+            name = found->second + "::" + name;
+        }
+
+        file << (i == 0 ? "\n" : ",\n")
+             << "{\"name\":\"" << name << "\",\"cat\":\"shape\",\"ph\":\"X\""
+             << ",\"ts\":" << (event.start - origin) / 1e3
+             << ",\"dur\":" << event.duration / 1e3
+             << ",\"pid\":1,\"tid\":" << event.threadId << "}";
+    }
+    file << "\n]}\n";
+
+    return static_cast<bool>(file);
+}
@@ -0,0 +1,107 @@
+#ifndef INSTRUMENTATION_H
+#define INSTRUMENTATION_H
+
+#include <array>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <typeinfo>
+
+// Счётчики вызовов и времени на горячих путях фигур. Включаются при
+// сборке с DEFINES += SHAPE_INSTRUMENTATION; без него макросы пустые,
+// а snapshot() возвращает нули.
+//
+// Каждый поток пишет в свои счётчики без блокировок. Вложенные вызовы
+// той же операции (Rhombus::rotate -> Polygon::rotate) учитываются один раз.
+class Instrumentation {
+public:
+    // Счётчики одного потока, определены в instrumentation.cpp
+    struct ThreadStats;
+
+    enum Operation : unsigned char {
+        Move,
+        Rotate,
+        Scale,
+        Area,
+        Perimeter,
+        Draw,
+        SetVertex,
+        RotatePoint,
+        ScalePoint,
+        CenterOfMass,
+        OperationCount
+    };
+
+    struct Stat {
+        uint64_t calls = 0;
+        uint64_t nanoseconds = 0;
+    };
+
+    using StatArray = std::array<Stat, OperationCount>;
+
+    struct Snapshot {
+        StatArray totals;
+        // По типам фигур (только операции, вызванные у фигуры)
+        std::map<std::string, StatArray> byType;
+    };
+
+    static constexpr bool compiledIn() {
+#ifdef SHAPE_INSTRUMENTATION
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    static const char *operationName(Operation operation);
+
+    // Читаемое имя типа (без декорирования компилятора)
+    static std::string typeName(const std::type_info &type);
+
+    // Сумма по всем потокам, включая завершившиеся
+    static Snapshot snapshot();
+    static void reset();
+
+    // Текстовая таблица для логов
+    static std::string format(const Snapshot &snapshot);
+
+    // События трассировки копятся, только пока она включена
+    static void setTracing(bool enabled);
+    static bool isTracing();
+
+    // Формат Chrome trace-event (chrome://tracing, Perfetto)
+    static bool writeChromeTrace(const std::string &path);
+
+    // Засекает время от конструктора до деструктора
+    class Probe {
+    public:
+        Probe(Operation operation, const std::type_info *type = nullptr);
+        ~Probe();
+
+        Probe(const Probe&) = delete;
+        Probe &operator=(const Probe&) = delete;
+
+    private:
+        ThreadStats *stats;
+        Operation operation;
+        bool outermost;
+        const std::type_info *type;
+        int64_t start;
+    };
+};
+
+#ifdef SHAPE_INSTRUMENTATION
+#define SHAPE_PROBE_CONCAT_(a, b) a##b
+#define SHAPE_PROBE_NAME_(line) SHAPE_PROBE_CONCAT_(shapeProbe_, line)
+// Операция свободной функции
+#define SHAPE_PROBE(operation) \
+    Instrumentation::Probe SHAPE_PROBE_NAME_(__LINE__)(Instrumentation::operation)
+// Операция фигуры с учётом её динамического типа
+#define SHAPE_PROBE_SHAPE(operation) \
+    Instrumentation::Probe SHAPE_PROBE_NAME_(__LINE__)(Instrumentation::operation, &typeid(*this))
+#else
+#define SHAPE_PROBE(operation) ((void)0)
+#define SHAPE_PROBE_SHAPE(operation) ((void)0)
+#endif
+
+#endif // INSTRUMENTATION_H
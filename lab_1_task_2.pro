@@ -8,34 +8,89 @@ CONFIG += c++17
 # In order to do so, uncomment the following line.
 #DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x060000    # disables all the APIs deprecated before Qt 6.0.0
 
+# Счётчики вызовов и времени операций фигур (instrumentation.h)
+#DEFINES += SHAPE_INSTRUMENTATION
+
 HEADERS += \
+    basicpolygon.h \
+    batchexporter.h \
     circle.h \
+    commandjournal.h \
+    coverage.h \
+    distancefield.h \
+    fixedpolygon.h \
+    geometrycore.h \
+    geometryjobs.h \
+    geometrylibrary.h \
     heart.h \
     hexagon.h \
+    instrumentation.h \
+    nesting.h \
+    offset.h \
+    parallel.h \
+    parametricshape.h \
+    performanceoverlay.h \
+    physics.h \
     polygon.h \
     quadrilateral.h \
     rectangle.h \
+    renderworker.h \
     rhombus.h \
+    scenecanvas.h \
+    scenestore.h \
     shape.h \
     mainwindow.h \
+    shapebatch.h \
+    shaperecognizer.h \
+    sharedvertices.h \
+    softwarerasterizer.h \
+    spatialindex.h \
     square.h \
     star.h \
-    triangle.h
+    threadpool.h \
+    transform2d.h \
+    triangle.h \
+    triangulation.h
 
 SOURCES += \
+    basicpolygon.cpp \
+    batchexporter.cpp \
     circle.cpp \
+    commandjournal.cpp \
+    coverage.cpp \
+    distancefield.cpp \
+    fixedpolygon.cpp \
+    geometrycore.cpp \
+    geometryjobs.cpp \
+    geometrylibrary.cpp \
     heart.cpp \
     hexagon.cpp \
+    instrumentation.cpp \
+    nesting.cpp \
+    offset.cpp \
+    parametricshape.cpp \
+    performanceoverlay.cpp \
+    physics.cpp \
     polygon.cpp \
     quadrilateral.cpp \
     rectangle.cpp \
+    renderworker.cpp \
     rhombus.cpp \
+    scenecanvas.cpp \
+    scenestore.cpp \
     shape.cpp \
     main.cpp \
     mainwindow.cpp \
+    shapebatch.cpp \
+    shaperecognizer.cpp \
+    softwarerasterizer.cpp \
+    spatialindex.cpp \
     square.cpp \
     star.cpp \
-    triangle.cpp
+    threadpool.cpp \
+    transform2d.cpp \
+    triangle.cpp \
+    triangulation.cpp
 
 FORMS += \
     mainwindow.ui
@@ -1,14 +1,234 @@
 #include "mainwindow.h"
 #include "ui_mainwindow.h"
+#include "circle.h"
+#include "heart.h"
+#include "hexagon.h"
+#include "performanceoverlay.h"
+#include "renderworker.h"
+#include "scenecanvas.h"
+#include "star.h"
+#include <QAction>
+#include <QLabel>
+#include <QMenu>
+#include <QMenuBar>
+#include <QStatusBar>
+#include <QTimer>
+
+// Запас на толщину пера и маркеры вершин/центра при отрисовке фигур
+static const double kDirtyMargin = 10.0;
+
+// Всё, что фигура может закрасить. В индексе хранится именно эта
+// область: фигура, задевающая очищаемый прямоугольник хотя бы пером
+// или маркером, должна попасть в перерисовку
+static QRectF drawnBounds(const Shape &shape) {
+    return shape.boundingRect().adjusted(-kDirtyMargin, -kDirtyMargin, kDirtyMargin, kDirtyMargin);
+}
+
+// Отступ оверлея производительности от угла холста
+static const int kOverlayMargin = 8;
+
+// Больше прямоугольников объединяются в один охватывающий
+static const size_t kMaxDirtyRects = 32;
+
+static void limitDirtyRects(std::vector<QRectF> &rects) {
+    if (rects.size() <= kMaxDirtyRects) return;
+
+    QRectF united = rects[0];
+    for (const QRectF &rect : rects) {
+        united = united.united(rect);
+    }
+    rects.assign(1, united);
+}
 
 MainWindow::MainWindow(QWidget *parent)
     : QMainWindow(parent)
     , ui(new Ui::MainWindow)
 {
     ui->setupUi(this);
+
+    canvas = new SceneCanvas(this);
+    setCentralWidget(canvas);
+
+    overlay = new PerformanceOverlay(canvas);
+    overlay->move(kOverlayMargin, kOverlayMargin);
+    overlay->hide();
+
+    frameSummary = new QLabel(this);
+    statusBar()->addWidget(frameSummary);
+
+    QMenu *editMenu = menuBar()->addMenu("Правка");
+    undoAction = editMenu->addAction("Отменить");
+    undoAction->setShortcut(QKeySequence::Undo);
+    redoAction = editMenu->addAction("Повторить");
+    redoAction->setShortcut(QKeySequence::Redo);
+    connect(undoAction, &QAction::triggered, this, &MainWindow::undo);
+    connect(redoAction, &QAction::triggered, this, &MainWindow::redo);
+    updateHistoryActions();
+
+    QMenu *viewMenu = menuBar()->addMenu("Вид");
+    QAction *overlayAction = viewMenu->addAction("Профилировщик");
+    overlayAction->setCheckable(true);
+    overlayAction->setShortcut(QKeySequence(Qt::Key_F12));
+    connect(overlayAction, &QAction::toggled, overlay, &QWidget::setVisible);
+
+    qRegisterMetaType<FrameStats>("FrameStats");
+
+    renderWorker = new RenderWorker();
+    renderWorker->moveToThread(&renderThread);
+    connect(&renderThread, &QThread::finished, renderWorker, &QObject::deleteLater);
+    connect(renderWorker, &RenderWorker::frameReady, this,
+            [this](const QImage &frame, const QPointF &offset, quint64 generation, const FrameStats &stats) {
+                if (generation <= presentedGeneration) return;
+                presentedGeneration = generation;
+                if (generation >= inFlightGeneration) {
+                    inFlightDirty.clear();
+                    fullRedrawInFlight = false;
+                }
+                canvas->presentFrame(frame, offset);
+
+                overlay->addFrame(stats);
+                frameSummary->setText(overlay->summary());
+            });
+    connect(renderWorker, &RenderWorker::fullRedrawRequired, this, &MainWindow::requestFullRedraw);
+    connect(canvas, &SceneCanvas::viewChanged, this, &MainWindow::requestFullRedraw);
+    renderThread.start();
+
+    populateDemoScene();
 }
 
 MainWindow::~MainWindow()
 {
+    renderWorker->cancel();
+    renderThread.quit();
+    renderThread.wait();
+
     delete ui;
 }
+
+void MainWindow::addShape(std::unique_ptr<Shape> shape) {
+    QRectF bounds = drawnBounds(*shape);
+    size_t index = scene.add(std::move(shape));
+    spatialIndex.insert(index, bounds);
+    markDirty(bounds);
+}
+
+std::shared_ptr<const Shape> MainWindow::shapeAt(size_t index) const {
+    return scene.read()->shared(index);
+}
+
+void MainWindow::transformShape(size_t index, const std::function<void(Shape&)> &edit) {
+    SceneStore::Transaction transaction(scene);
+
+    QRectF oldBounds = drawnBounds(transaction.at(index));
+    transaction.edit(index, edit);
+    QRectF newBounds = drawnBounds(transaction.at(index));
+
+    transaction.commit();
+
+    spatialIndex.update(index, newBounds);
+    markDirty(oldBounds);
+    markDirty(newBounds);
+}
+
+void MainWindow::execute(const ShapeCommand &command) {
+    transformShape(command.shapeIndex, [&](Shape &shape) {
+        journal.execute(shape, command);
+    });
+    updateHistoryActions();
+}
+
+void MainWindow::undo() {
+    if (!journal.canUndo()) return;
+
+    transformShape(journal.undoTarget(), [this](Shape &shape) {
+        journal.undo([&shape](size_t) -> Shape& { return shape; });
+    });
+    updateHistoryActions();
+}
+
+void MainWindow::redo() {
+    if (!journal.canRedo()) return;
+
+    transformShape(journal.redoTarget(), [this](Shape &shape) {
+        journal.redo([&shape](size_t) -> Shape& { return shape; });
+    });
+    updateHistoryActions();
+}
+
+void MainWindow::updateHistoryActions() {
+    undoAction->setEnabled(journal.canUndo());
+    redoAction->setEnabled(journal.canRedo());
+}
+
+void MainWindow::sceneChanged() {
+    SceneStore::ReadGuard snapshot = scene.read();
+
+    spatialIndex.clear();
+    for (size_t i = 0; i < snapshot->size(); ++i) {
+        spatialIndex.insert(i, drawnBounds(snapshot->at(i)));
+    }
+    requestFullRedraw();
+}
+
+void MainWindow::markDirty(const QRectF &drawnRect) {
+    pendingDirty.push_back(drawnRect);
+    limitDirtyRects(pendingDirty);
+
+    scheduleRender();
+}
+
+void MainWindow::requestFullRedraw() {
+    fullRedrawPending = true;
+    scheduleRender();
+}
+
+void MainWindow::scheduleRender() {
+    if (renderScheduled) return;
+    renderScheduled = true;
+
+    QTimer::singleShot(0, this, [this]() {
+        renderScheduled = false;
+        submitRender();
+    });
+}
+
+void MainWindow::submitRender() {
+    RenderRequest request;
+    request.size = canvas->size();
+    request.offset = canvas->viewOffset();
+
+    // Пока не показан полный кадр, опереться на сохранённый нельзя
+    request.fullRedraw = fullRedrawPending || fullRedrawInFlight;
+
+    // Версия сцены неизменяема, поэтому фигуры не копируются; чтение
+    // не ждёт открытых транзакций (например, фоновой задачи над сценой)
+    request.scene = scene.read().retain();
+
+    if (request.fullRedraw) {
+        inFlightDirty.clear();
+        fullRedrawInFlight = true;
+    } else {
+        // Прерванный предыдущий запрос мог не дорисовать свои области
+        inFlightDirty.insert(inFlightDirty.end(), pendingDirty.begin(), pendingDirty.end());
+        limitDirtyRects(inFlightDirty);
+        request.dirtyRects = inFlightDirty;
+
+        request.indices = spatialIndex.query(request.dirtyRects);
+    }
+
+    pendingDirty.clear();
+    fullRedrawPending = false;
+
+    inFlightGeneration = renderWorker->submit(request);
+}
+
+void MainWindow::populateDemoScene() {
+    SceneStore::Transaction transaction(scene);
+    transaction.add(std::make_unique<Circle>(150.0, 150.0, 60.0));
+    transaction.add(std::make_unique<Star5>(350.0, 150.0, 80.0, 32.0));
+    transaction.add(std::make_unique<Hexagon>(550.0, 150.0, 70.0));
+    transaction.add(std::make_unique<Heart>(350.0, 380.0, 90.0, 100));
+    transaction.commit();
+
+    sceneChanged();
+}
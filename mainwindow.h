@@ -1,7 +1,21 @@
 #ifndef MAINWINDOW_H
 #define MAINWINDOW_H
 
+#include "commandjournal.h"
+#include "scenestore.h"
+#include "shape.h"
+#include "spatialindex.h"
 #include <QMainWindow>
+#include <QThread>
+#include <functional>
+#include <memory>
+#include <vector>
+
+class PerformanceOverlay;
+class QAction;
+class QLabel;
+class RenderWorker;
+class SceneCanvas;
 
 QT_BEGIN_NAMESPACE
 namespace Ui {
@@ -17,7 +31,54 @@ public:
     MainWindow(QWidget *parent = nullptr);
     ~MainWindow();
 
+    void addShape(std::unique_ptr<Shape> shape);
+    size_t shapeCount() const { return scene.read()->size(); }
+    std::shared_ptr<const Shape> shapeAt(size_t index) const;
+
+    // Версии сцены для запросов из других потоков
+    const SceneStore &sceneStore() const { return scene; }
+
+    // Изменяет копию фигуры, публикует новую версию сцены и перерисовывает
+    // только объединение старого и нового ограничивающих прямоугольников
+    void transformShape(size_t index, const std::function<void(Shape&)> &edit);
+
+    // Выполняет команду с записью в журнал отмены
+    void execute(const ShapeCommand &command);
+    void undo();
+    void redo();
+
+    // Полная перерисовка после произвольных изменений фигур
+    void sceneChanged();
+
 private:
     Ui::MainWindow *ui;
+    SceneCanvas *canvas;
+    PerformanceOverlay *overlay;
+    QLabel *frameSummary;
+    QThread renderThread;
+    RenderWorker *renderWorker;
+    SceneStore scene;
+    SpatialIndex spatialIndex;
+    CommandJournal journal;
+    QAction *undoAction;
+    QAction *redoAction;
+
+    quint64 presentedGeneration = 0;
+    bool renderScheduled = false;
+
+    // Грязные области, ещё не отправленные и отправленные, но не показанные
+    std::vector<QRectF> pendingDirty;
+    std::vector<QRectF> inFlightDirty;
+    quint64 inFlightGeneration = 0;
+    bool fullRedrawPending = true;
+    bool fullRedrawInFlight = false;
+
+    // Область из drawnBounds(): очищается и перерисовывается целиком
+    void markDirty(const QRectF &drawnRect);
+    void requestFullRedraw();
+    void scheduleRender();
+    void submitRender();
+    void updateHistoryActions();
+    void populateDemoScene();
 };
 #endif // MAINWINDOW_H
@@ -0,0 +1,408 @@
+#include "nesting.h"
+#include "circle.h"
+#include "offset.h"
+#include "parallel.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <iomanip>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+
+using Hull = std::vector<QPointF>;
+
+static double cross(const QPointF &o, const QPointF &a, const QPointF &b) {
+    return (a.x() - o.x()) * (b.y() - o.y()) - (a.y() - o.y()) * (b.x() - o.x());
+}
+
+// Начало обхода — вершина с наименьшим y (затем x): с неё рёбра
+// выпуклого многоугольника идут по возрастанию полярного угла
+static Hull startingAtLowest(const Hull &polygon) {
+    size_t lowest = 0;
+    for (size_t i = 1; i < polygon.size(); ++i) {
+        if (polygon[i].y() < polygon[lowest].y() ||
+            (polygon[i].y() == polygon[lowest].y() && polygon[i].x() < polygon[lowest].x())) {
+            lowest = i;
+        }
+    }
+
+    Hull result(polygon.size());
+    for (size_t i = 0; i < polygon.size(); ++i) {
+        result[i] = polygon[(lowest + i) % polygon.size()];
+    }
+    return result;
+}
+
+// Сумма Минковского выпуклых многоугольников слиянием рёбер, O(n + m)
+static Hull minkowskiSum(const Hull &first, const Hull &second) {
+    const Hull a = startingAtLowest(first);
+    const Hull b = startingAtLowest(second);
+    const size_t n = a.size();
+    const size_t m = b.size();
+
+    Hull result;
+    result.reserve(n + m);
+
+    size_t i = 0;
+    size_t j = 0;
+    while (i < n || j < m) {
+        result.push_back(a[i % n] + b[j % m]);
+        QPointF edgeA = a[(i + 1) % n] - a[i % n];
+        QPointF edgeB = b[(j + 1) % m] - b[j % m];
+        double turn = edgeA.x() * edgeB.y() - edgeA.y() * edgeB.x();
+        if (j == m || (i < n && turn >= 0.0)) ++i;
+        if (i == n + 1 || (j < m && turn <= 0.0)) ++j;
+        if (i > n) i = n;
+    }
+
+    return convexHullOf(result);
+}
+
+struct PartGeometry {
+    // Одинаковые по форме детали получают один номер и общие годографы
+    size_t form = 0;
+    // Оболочки для каждого угла относительно центра детали
+    std::vector<Hull> hulls;
+    std::vector<QRectF> bounds;
+    double area = 0.0;
+};
+
+class NfpCache {
+private:
+    std::mutex mutex;
+    std::map<std::array<size_t, 4>, std::shared_ptr<const Hull>> entries;
+
+public:
+    std::atomic<size_t> computed{0};
+    std::atomic<size_t> reused{0};
+
+    // Положения центра подвижной детали, при которых она перекрывает
+    // неподвижную, стоящую центром в начале координат
+    std::shared_ptr<const Hull> get(const PartGeometry &fixed, size_t fixedAngle,
+                                    const PartGeometry &moving, size_t movingAngle) {
+        const std::array<size_t, 4> key = {fixed.form, fixedAngle, moving.form, movingAngle};
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            auto it = entries.find(key);
+            if (it != entries.end()) {
+                ++reused;
+                return it->second;
+            }
+        }
+
+        Hull reflected = moving.hulls[movingAngle];
+        for (QPointF &p : reflected) p = QPointF(-p.x(), -p.y());
+        auto nfp = std::make_shared<const Hull>(minkowskiSum(fixed.hulls[fixedAngle], reflected));
+
+        std::lock_guard<std::mutex> lock(mutex);
+        auto inserted = entries.emplace(key, nfp);
+        if (inserted.second) ++computed;
+        return inserted.first->second;
+    }
+};
+
+struct PlacedItem {
+    size_t part;
+    size_t angle;
+    QPointF position;
+};
+
+struct Sheet {
+    std::vector<PlacedItem> items;
+    double partArea = 0.0;
+};
+
+// Точка строго внутри выпуклого многоугольника (касание допускается)
+static bool strictlyInside(const Hull &polygon, const QPointF &offset, const QPointF &p, double epsilon) {
+    const size_t n = polygon.size();
+    for (size_t i = 0; i < n; ++i) {
+        QPointF a = polygon[i] + offset;
+        QPointF b = polygon[(i + 1) % n] + offset;
+        QPointF edge = b - a;
+        double length = std::sqrt(edge.x() * edge.x() + edge.y() * edge.y());
+        if (cross(a, b, p) <= epsilon * length) return false;
+    }
+    return true;
+}
+
+static bool segmentIntersection(const QPointF &a, const QPointF &b, const QPointF &c, const QPointF &d,
+                                QPointF &point) {
+    QPointF r = b - a;
+    QPointF s = d - c;
+    double denominator = r.x() * s.y() - r.y() * s.x();
+    if (std::abs(denominator) < 1e-18) return false;
+
+    QPointF ac = c - a;
+    double t = (ac.x() * s.y() - ac.y() * s.x()) / denominator;
+    double u = (ac.x() * r.y() - ac.y() * r.x()) / denominator;
+    if (t < 0.0 || t > 1.0 || u < 0.0 || u > 1.0) return false;
+
+    point = a + r * t;
+    return true;
+}
+
+// Самая нижняя-левая допустимая позиция центра детали на листе
+static bool findPosition(const Sheet &sheet, size_t part, size_t angle,
+                         const std::vector<PartGeometry> &geometry, NfpCache &cache,
+                         const NestingOptions &options, QPointF &position) {
+    const PartGeometry &moving = geometry[part];
+    const QRectF &b = moving.bounds[angle];
+    const double margin = 0.5 * options.spacing;
+    const double epsilon = 1e-9 * std::max(options.sheetWidth, options.sheetHeight);
+
+    // Область, где оболочка детали целиком на листе (inner-fit rectangle)
+    const double x0 = margin - b.left();
+    const double y0 = margin - b.top();
+    const double x1 = options.sheetWidth - margin - b.right();
+    const double y1 = options.sheetHeight - margin - b.bottom();
+    if (x1 < x0 - epsilon || y1 < y0 - epsilon) return false;
+    const QRectF fit(x0, y0, std::max(0.0, x1 - x0), std::max(0.0, y1 - y0));
+
+    struct Obstacle {
+        std::shared_ptr<const Hull> nfp;
+        QPointF offset;
+        QRectF bounds;
+    };
+    std::vector<Obstacle> obstacles;
+    for (const PlacedItem &item : sheet.items) {
+        auto nfp = cache.get(geometry[item.part], item.angle, moving, angle);
+        QRectF bounds = boundingRectOf(*nfp).translated(item.position);
+        if (bounds.right() < fit.left() || bounds.left() > fit.right() ||
+            bounds.bottom() < fit.top() || bounds.top() > fit.bottom()) {
+            continue;
+        }
+        obstacles.push_back({nfp, item.position, bounds});
+    }
+
+    auto insideFit = [&](const QPointF &p) {
+        return p.x() >= fit.left() - epsilon && p.x() <= fit.right() + epsilon &&
+               p.y() >= fit.top() - epsilon && p.y() <= fit.bottom() + epsilon;
+    };
+
+    // Кандидаты: углы области, вершины годографов и пересечения их рёбер
+    // с краями области и друг с другом
+    std::vector<QPointF> candidates = {fit.topLeft(), fit.topRight(), fit.bottomLeft(), fit.bottomRight()};
+    const QPointF fitCorners[4] = {fit.topLeft(), fit.topRight(), fit.bottomRight(), fit.bottomLeft()};
+
+    for (const Obstacle &obstacle : obstacles) {
+        const Hull &hull = *obstacle.nfp;
+        for (size_t k = 0; k < hull.size(); ++k) {
+            QPointF a = hull[k] + obstacle.offset;
+            QPointF c = hull[(k + 1) % hull.size()] + obstacle.offset;
+            if (insideFit(a)) candidates.push_back(a);
+
+            QPointF point;
+            for (int side = 0; side < 4; ++side) {
+                if (segmentIntersection(a, c, fitCorners[side], fitCorners[(side + 1) % 4], point)) {
+                    candidates.push_back(point);
+                }
+            }
+        }
+    }
+
+    for (size_t i = 0; i < obstacles.size(); ++i) {
+        for (size_t j = i + 1; j < obstacles.size(); ++j) {
+            const QRectF overlap = obstacles[i].bounds.intersected(obstacles[j].bounds);
+            if (overlap.isEmpty()) continue;
+
+            // Рёбра второго годографа, попадающие в общую часть прямоугольников
+            const Hull &other = *obstacles[j].nfp;
+            std::vector<std::pair<QPointF, QPointF>> edges;
+            for (size_t l = 0; l < other.size(); ++l) {
+                QPointF e = other[l] + obstacles[j].offset;
+                QPointF f = other[(l + 1) % other.size()] + obstacles[j].offset;
+                if (boundingRectOf({e, f}).adjusted(-epsilon, -epsilon, epsilon, epsilon).intersects(overlap)) {
+                    edges.emplace_back(e, f);
+                }
+            }
+
+            const Hull &hull = *obstacles[i].nfp;
+            for (size_t k = 0; k < hull.size(); ++k) {
+                QPointF a = hull[k] + obstacles[i].offset;
+                QPointF c = hull[(k + 1) % hull.size()] + obstacles[i].offset;
+                QPointF point;
+                for (const auto &edge : edges) {
+                    if (segmentIntersection(a, c, edge.first, edge.second, point) && insideFit(point)) {
+                        candidates.push_back(point);
+                    }
+                }
+            }
+        }
+    }
+
+    std::sort(candidates.begin(), candidates.end(), [](const QPointF &l, const QPointF &r) {
+        return l.y() < r.y() || (l.y() == r.y() && l.x() < r.x());
+    });
+
+    for (QPointF candidate : candidates) {
+        candidate.setX(std::clamp(candidate.x(), fit.left(), fit.right()));
+        candidate.setY(std::clamp(candidate.y(), fit.top(), fit.bottom()));
+
+        bool blocked = false;
+        for (const Obstacle &obstacle : obstacles) {
+            if (candidate.x() <= obstacle.bounds.left() || candidate.x() >= obstacle.bounds.right() ||
+                candidate.y() <= obstacle.bounds.top() || candidate.y() >= obstacle.bounds.bottom()) {
+                continue;
+            }
+            if (strictlyInside(*obstacle.nfp, obstacle.offset, candidate, epsilon)) {
+                blocked = true;
+                break;
+            }
+        }
+
+        if (!blocked) {
+            position = candidate;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static std::vector<PartGeometry> buildGeometry(const std::vector<const Shape*> &parts,
+                                               const NestingOptions &options) {
+    std::vector<PartGeometry> geometry(parts.size());
+    std::map<std::vector<long long>, size_t> forms;
+
+    for (size_t i = 0; i < parts.size(); ++i) {
+        const Shape &shape = *parts[i];
+        const QPointF center(shape.getCenterX(), shape.getCenterY());
+
+        std::vector<QPointF> points = shape.outline();
+        for (QPointF &p : points) p -= center;
+        Hull hull = convexHullOf(points);
+
+        // Контур круга вписан в окружность; оболочку раздвигаем до неё
+        double inflate = 0.5 * options.spacing;
+        if (const Circle *circle = dynamic_cast<const Circle*>(&shape)) {
+            inflate += circle->getRadius() * (1.0 - std::cos(M_PI / std::max<size_t>(points.size(), 3)));
+        }
+        if (inflate > 0.0 && hull.size() >= 3) {
+            std::vector<std::vector<QPointF>> inflated = offsetPolygon(hull, inflate);
+            if (!inflated.empty()) hull = convexHullOf(inflated.front());
+        }
+
+        std::vector<long long> key;
+        key.reserve(2 * hull.size());
+        for (const QPointF &p : hull) {
+            key.push_back(std::llround(p.x() * 1e6));
+            key.push_back(std::llround(p.y() * 1e6));
+        }
+        geometry[i].form = forms.emplace(key, forms.size()).first->second;
+
+        for (int step = 0; step < options.rotationSteps; ++step) {
+            double angle = 360.0 * step / options.rotationSteps;
+            Hull rotated = hull;
+            for (QPointF &p : rotated) p = rotatePoint(p, angle, 0.0, 0.0);
+            geometry[i].bounds.push_back(boundingRectOf(rotated));
+            geometry[i].hulls.push_back(std::move(rotated));
+        }
+        geometry[i].area = shape.area();
+    }
+
+    return geometry;
+}
+
+NestingResult nestShapes(const std::vector<const Shape*> &parts, const NestingOptions &options) {
+    if (options.sheetWidth <= 0.0 || options.sheetHeight <= 0.0) {
+        throw std::invalid_argument(
+            "Размеры листа должны быть положительными. Передано: " +
+            std::to_string(options.sheetWidth) + "x" + std::to_string(options.sheetHeight)
+            );
+    }
+
+    if (options.spacing < 0.0) {
+        throw std::invalid_argument("Зазор не может быть отрицательным. Передано: " +
+                                    std::to_string(options.spacing));
+    }
+
+    if (options.rotationSteps < 1) {
+        throw std::invalid_argument("Число поворотов должно быть >= 1. Передано: " +
+                                    std::to_string(options.rotationSteps));
+    }
+
+    const std::vector<PartGeometry> geometry = buildGeometry(parts, options);
+    const size_t angleCount = static_cast<size_t>(options.rotationSteps);
+
+    std::vector<size_t> order(parts.size());
+    for (size_t i = 0; i < order.size(); ++i) order[i] = i;
+    std::stable_sort(order.begin(), order.end(), [&](size_t l, size_t r) {
+        return geometry[l].area > geometry[r].area;
+    });
+
+    NfpCache cache;
+    std::vector<Sheet> sheets;
+    NestingResult result;
+
+    for (size_t part : order) {
+        // Пустой лист в конце: если деталь не встала на имеющиеся
+        bool placed = false;
+        for (size_t s = 0; s <= sheets.size() && !placed; ++s) {
+            const Sheet empty;
+            const Sheet &sheet = s < sheets.size() ? sheets[s] : empty;
+
+            std::vector<char> found(angleCount, 0);
+            std::vector<QPointF> positions(angleCount);
+            parallelFor(angleCount, [&](size_t angle) {
+                found[angle] = findPosition(sheet, part, angle, geometry, cache, options, positions[angle]);
+            });
+
+            size_t best = angleCount;
+            for (size_t angle = 0; angle < angleCount; ++angle) {
+                if (!found[angle]) continue;
+                if (best == angleCount ||
+                    positions[angle].y() < positions[best].y() ||
+                    (positions[angle].y() == positions[best].y() && positions[angle].x() < positions[best].x())) {
+                    best = angle;
+                }
+            }
+            if (best == angleCount) continue;
+
+            if (s == sheets.size()) sheets.emplace_back();
+            sheets[s].items.push_back({part, best, positions[best]});
+            sheets[s].partArea += geometry[part].area;
+            result.placements.push_back({part, s, 360.0 * best / options.rotationSteps, positions[best]});
+            placed = true;
+        }
+
+        if (!placed) result.unplaced.push_back(part);
+    }
+
+    const double sheetArea = options.sheetWidth * options.sheetHeight;
+    double usedArea = 0.0;
+    result.sheetCount = sheets.size();
+    for (const Sheet &sheet : sheets) {
+        result.sheetUtilization.push_back(sheet.partArea / sheetArea);
+        usedArea += sheet.partArea;
+    }
+    result.utilization = sheets.empty() ? 0.0 : usedArea / (sheetArea * sheets.size());
+    result.nfpComputed = cache.computed;
+    result.nfpReused = cache.reused;
+    return result;
+}
+
+std::unique_ptr<Shape> placedShape(const Shape &part, const Placement &placement) {
+    std::unique_ptr<Shape> shape = part.clone();
+    shape->rotate(placement.angle, shape->getCenterX(), shape->getCenterY());
+    shape->setCenterOfMass(placement.position);
+    return shape;
+}
+
+std::string formatNestingReport(const NestingResult &result) {
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(1);
+
+    out << "Листов: " << result.sheetCount
+        << ", деталей: " << result.placements.size()
+        << ", не поместилось: " << result.unplaced.size() << "\n";
+    for (size_t i = 0; i < result.sheetUtilization.size(); ++i) {
+        out << "  лист " << i + 1 << ": " << result.sheetUtilization[i] * 100.0 << "%\n";
+    }
+    out << "Заполнение в среднем: " << result.utilization * 100.0 << "%\n";
+    out << "Годографы: вычислено " << result.nfpComputed
+        << ", из кэша " << result.nfpReused << "\n";
+    return out.str();
+}
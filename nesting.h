@@ -0,0 +1,60 @@
+#ifndef NESTING_H
+#define NESTING_H
+
+#include "shape.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+// Раскрой деталей на листы материала эвристикой «снизу-слева»
+// (bottom-left fill). Детали обрабатываются по убыванию площади; каждая
+// ставится на первый лист, где для какого-нибудь угла поворота есть
+// место, в самую близкую к углу (0, 0) допустимую позицию — с наименьшим
+// y, затем x.
+//
+// Допустимые позиции ищутся по годографам (no-fit polygon) выпуклых
+// оболочек деталей: сумма Минковского оболочки стоящей детали и
+// отражённой оболочки новой. Годографы не зависят от положения деталей
+// и кэшируются по паре форм и паре углов, поэтому одинаковые детали
+// считают их один раз. Углы поворота проверяются параллельно.
+//
+// Детали раскладываются по выпуклым оболочкам: вогнутости (между лучами
+// звезды, у выемки сердца) другими деталями не заполняются.
+
+struct NestingOptions {
+    double sheetWidth = 1000.0;
+    double sheetHeight = 1000.0;
+    // Наименьший зазор между деталями и от деталей до края листа
+    double spacing = 0.0;
+    // Углы 0, 360 / rotationSteps, ...; 1 — без поворотов
+    int rotationSteps = 4;
+};
+
+struct Placement {
+    size_t part;      // индекс в списке деталей
+    size_t sheet;
+    double angle;     // поворот вокруг центра детали, градусы
+    QPointF position; // куда переносится центр детали на листе
+};
+
+struct NestingResult {
+    std::vector<Placement> placements;
+    // Детали, не помещающиеся даже на пустой лист
+    std::vector<size_t> unplaced;
+    size_t sheetCount = 0;
+    // Доля площади листа, занятая деталями
+    std::vector<double> sheetUtilization;
+    double utilization = 0.0;
+    size_t nfpComputed = 0;
+    size_t nfpReused = 0;
+};
+
+NestingResult nestShapes(const std::vector<const Shape*> &parts, const NestingOptions &options);
+
+// Копия детали, повёрнутая и перенесённая на своё место на листе
+std::unique_ptr<Shape> placedShape(const Shape &part, const Placement &placement);
+
+// Текстовый отчёт: заполнение листов и работа кэша годографов
+std::string formatNestingReport(const NestingResult &result);
+
+#endif // NESTING_H
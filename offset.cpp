@@ -0,0 +1,460 @@
+#include "offset.h"
+#include "circle.h"
+#include "parallel.h"
+#include "polygon.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+static double cross(const QPointF &a, const QPointF &b) {
+    return a.x() * b.y() - a.y() * b.x();
+}
+
+static double dot(const QPointF &a, const QPointF &b) {
+    return a.x() * b.x() + a.y() * b.y();
+}
+
+static double signedArea(const std::vector<QPointF> &points) {
+    double area = 0.0;
+    for (size_t i = 0, n = points.size(); i < n; ++i) {
+        area += cross(points[i], points[(i + 1) % n]);
+    }
+    return 0.5 * area;
+}
+
+static bool containsPoint(const std::vector<QPointF> &polygon, const QPointF &p) {
+    bool inside = false;
+    for (size_t i = 0, j = polygon.size() - 1; i < polygon.size(); j = i++) {
+        const QPointF &a = polygon[i];
+        const QPointF &b = polygon[j];
+        if ((a.y() > p.y()) != (b.y() > p.y()) &&
+            p.x() < (b.x() - a.x()) * (p.y() - a.y()) / (b.y() - a.y()) + a.x()) {
+            inside = !inside;
+        }
+    }
+    return inside;
+}
+
+// Сырой смещённый контур: рёбра сдвинуты по нормали, на стороне смещения
+// углы соединяются остриём или дугой, на другой стороне — через саму
+// вершину. Лишние петли убираются потом.
+static std::vector<QPointF> rawOffset(const std::vector<QPointF> &polygon, double distance,
+                                      const OffsetOptions &options) {
+    const size_t n = polygon.size();
+    const double d = std::abs(distance);
+    const double side = distance > 0.0 ? 1.0 : -1.0;
+
+    std::vector<QPointF> directions(n);
+    std::vector<QPointF> normals(n);
+    std::vector<double> lengths(n);
+    for (size_t i = 0; i < n; ++i) {
+        QPointF edge = polygon[(i + 1) % n] - polygon[i];
+        lengths[i] = std::sqrt(dot(edge, edge));
+        edge /= lengths[i];
+        directions[i] = edge;
+        // Наружная нормаль при положительном обходе
+        normals[i] = QPointF(edge.y(), -edge.x());
+    }
+
+    // Шаг дуги, при котором описанная ломаная отходит от дуги не дальше допуска
+    const double arcStep = 2.0 * std::acos(d / (d + options.arcTolerance));
+
+    std::vector<QPointF> result;
+    result.reserve(3 * n);
+
+    for (size_t i = 0; i < n; ++i) {
+        const QPointF &p = polygon[i];
+        const QPointF &u0 = directions[(i + n - 1) % n];
+        const QPointF &u1 = directions[i];
+        const QPointF &n0 = normals[(i + n - 1) % n];
+        const QPointF &n1 = normals[i];
+        const QPointF a = p + n0 * distance;
+        const QPointF b = p + n1 * distance;
+
+        double turn = cross(u0, u1);
+        double straight = dot(u0, u1);
+
+        if (std::abs(turn) < 1e-12 && straight > 0.0) {
+            result.push_back(a);
+            continue;
+        }
+
+        if (turn * side < 0.0) {
+            // Соседние смещённые рёбра пересекаются на расстоянии
+            // d * tan(половины угла) от концов. Если это в пределах
+            // половины каждого ребра, точка пересечения и есть вершина
+            // результата — без петли, которую потом пришлось бы вырезать.
+            double halfTan = std::abs(turn) / (1.0 + straight);
+            if (straight > 0.0 && d * halfTan <= 0.5 * std::min(lengths[(i + n - 1) % n], lengths[i])) {
+                result.push_back(p + (n0 + n1) * (distance / (1.0 + dot(n0, n1))));
+                continue;
+            }
+
+            result.push_back(a);
+            result.push_back(p);
+            result.push_back(b);
+            continue;
+        }
+
+        if (options.join == OffsetJoin::Round) {
+            double start = std::atan2(side * n0.y(), side * n0.x());
+            double sweep = std::atan2(cross(n0, n1), dot(n0, n1));
+            if (std::abs(turn) < 1e-12) sweep = side * M_PI;
+
+            int steps = std::max(1, static_cast<int>(std::ceil(std::abs(sweep) / arcStep)));
+            double step = sweep / steps;
+            double radius = d / std::cos(0.5 * step);
+
+            result.push_back(a);
+            for (int k = 0; k < steps; ++k) {
+                double angle = start + (k + 0.5) * step;
+                result.emplace_back(p.x() + radius * std::cos(angle), p.y() + radius * std::sin(angle));
+            }
+            result.push_back(b);
+            continue;
+        }
+
+        // Длина острия в долях d равна 1 / cos(половины угла поворота)
+        QPointF bisector = n0 + n1;
+        double bisectorLength = std::sqrt(dot(bisector, bisector));
+        double halfCos = 0.5 * bisectorLength;
+
+        if (halfCos * options.miterLimit >= 1.0) {
+            result.push_back(p + bisector * (distance / (1.0 + dot(n0, n1))));
+            continue;
+        }
+
+        // Острие срезается поперёк биссектрисы на расстоянии miterLimit * d
+        QPointF axis = bisectorLength > 1e-12 ? bisector * (side / bisectorLength) : u0;
+        double reach = (options.miterLimit * d - d * halfCos) / dot(u0, axis);
+        result.push_back(a + u0 * reach);
+        result.push_back(b - u1 * reach);
+    }
+
+    return result;
+}
+
+// Равномерная сетка по отрезкам для поиска самопересечений
+class SegmentGrid {
+private:
+    const std::vector<QPointF> &ring;
+    QRectF bounds;
+    int columns;
+    int rows;
+    double cellWidth;
+    double cellHeight;
+
+public:
+    std::vector<std::vector<uint32_t>> cells;
+
+    explicit SegmentGrid(const std::vector<QPointF> &points)
+        : ring(points)
+    {
+        bounds = boundingRectOf(ring);
+        int side = std::max(1, static_cast<int>(std::ceil(std::sqrt(static_cast<double>(ring.size())))));
+        columns = side;
+        rows = side;
+        cellWidth = std::max(bounds.width() / columns, 1e-12);
+        cellHeight = std::max(bounds.height() / rows, 1e-12);
+        cells.resize(static_cast<size_t>(columns) * rows);
+
+        for (size_t i = 0, n = ring.size(); i < n; ++i) {
+            const QPointF &a = ring[i];
+            const QPointF &b = ring[(i + 1) % n];
+            int c0 = column(std::min(a.x(), b.x()));
+            int c1 = column(std::max(a.x(), b.x()));
+            int r0 = row(std::min(a.y(), b.y()));
+            int r1 = row(std::max(a.y(), b.y()));
+            for (int r = r0; r <= r1; ++r) {
+                for (int c = c0; c <= c1; ++c) {
+                    cells[static_cast<size_t>(r) * columns + c].push_back(static_cast<uint32_t>(i));
+                }
+            }
+        }
+    }
+
+    int column(double x) const {
+        return std::clamp(static_cast<int>((x - bounds.left()) / cellWidth), 0, columns - 1);
+    }
+
+    int row(double y) const {
+        return std::clamp(static_cast<int>((y - bounds.top()) / cellHeight), 0, rows - 1);
+    }
+
+    size_t cellOf(const QPointF &p) const {
+        return static_cast<size_t>(row(p.y())) * columns + column(p.x());
+    }
+
+    // Число оборотов контура вокруг точки. Луч вправо от p проходит
+    // только по одной строке сетки; отрезок учитывается в ячейке,
+    // где он пересекает луч.
+    int winding(const QPointF &p) const {
+        const int r = row(p.y());
+        const size_t n = ring.size();
+        int result = 0;
+        for (int c = column(p.x()); c < columns; ++c) {
+            for (uint32_t i : cells[static_cast<size_t>(r) * columns + c]) {
+                const QPointF &a = ring[i];
+                const QPointF &b = ring[(i + 1) % n];
+                int direction = 0;
+                if (a.y() <= p.y()) {
+                    if (b.y() > p.y() && cross(b - a, p - a) > 0.0) direction = 1;
+                } else if (b.y() <= p.y() && cross(b - a, p - a) < 0.0) {
+                    direction = -1;
+                }
+                if (direction == 0) continue;
+
+                double x = a.x() + (p.y() - a.y()) * (b.x() - a.x()) / (b.y() - a.y());
+                if (column(x) == c) result += direction;
+            }
+        }
+        return result;
+    }
+};
+
+// Разрезает контур в точках самопересечения на простые петли
+static std::vector<std::vector<QPointF>> splitLoops(const std::vector<QPointF> &ring, const SegmentGrid &grid) {
+    const size_t n = ring.size();
+
+    struct Crossing {
+        double t;
+        uint32_t id;
+    };
+    std::vector<std::vector<Crossing>> crossings(n);
+    std::vector<QPointF> points;
+
+    for (size_t cell = 0; cell < grid.cells.size(); ++cell) {
+        const std::vector<uint32_t> &segments = grid.cells[cell];
+        for (size_t x = 0; x < segments.size(); ++x) {
+            for (size_t y = x + 1; y < segments.size(); ++y) {
+                uint32_t i = std::min(segments[x], segments[y]);
+                uint32_t j = std::max(segments[x], segments[y]);
+                if (j == i + 1 || (i == 0 && j == n - 1)) continue;
+
+                const QPointF &a = ring[i];
+                const QPointF &b = ring[(i + 1) % n];
+                const QPointF &c = ring[j];
+                const QPointF &e = ring[(j + 1) % n];
+                QPointF r = b - a;
+                QPointF s = e - c;
+                double denominator = cross(r, s);
+                if (std::abs(denominator) < 1e-18) continue;
+
+                double t = cross(c - a, s) / denominator;
+                double u = cross(c - a, r) / denominator;
+                // Полуинтервалы, чтобы общая вершина не считалась дважды
+                if (t < 0.0 || t >= 1.0 || u < 0.0 || u >= 1.0) continue;
+
+                QPointF point = a + r * t;
+                // Пара отрезков встречается в нескольких ячейках —
+                // учитываем её только в ячейке точки пересечения
+                if (grid.cellOf(point) != cell) continue;
+
+                uint32_t id = static_cast<uint32_t>(points.size());
+                points.push_back(point);
+                crossings[i].push_back({t, id});
+                crossings[j].push_back({u, id});
+            }
+        }
+    }
+
+    std::vector<std::vector<QPointF>> loops;
+    if (points.empty()) {
+        loops.push_back(ring);
+        return loops;
+    }
+
+    // Обход со стеком: повторная встреча точки пересечения замыкает петлю
+    struct Node {
+        QPointF point;
+        int64_t id;
+    };
+    std::vector<Node> stack;
+    stack.reserve(n + 2 * points.size());
+    std::vector<int64_t> position(points.size(), -1);
+
+    auto visit = [&](const QPointF &point, int64_t id) {
+        if (id >= 0 && position[id] >= 0) {
+            size_t from = static_cast<size_t>(position[id]);
+            std::vector<QPointF> loop;
+            loop.reserve(stack.size() - from);
+            for (size_t k = from; k < stack.size(); ++k) {
+                loop.push_back(stack[k].point);
+                if (k > from && stack[k].id >= 0) position[stack[k].id] = -1;
+            }
+            loops.push_back(std::move(loop));
+            stack.resize(from + 1);
+            return;
+        }
+        if (id >= 0) position[id] = static_cast<int64_t>(stack.size());
+        stack.push_back({point, id});
+    };
+
+    for (size_t i = 0; i < n; ++i) {
+        visit(ring[i], -1);
+        std::vector<Crossing> &list = crossings[i];
+        std::sort(list.begin(), list.end(), [](const Crossing &l, const Crossing &r) { return l.t < r.t; });
+        for (const Crossing &crossing : list) {
+            visit(points[crossing.id], crossing.id);
+        }
+    }
+
+    std::vector<QPointF> rest;
+    rest.reserve(stack.size());
+    for (const Node &node : stack) rest.push_back(node.point);
+    loops.push_back(std::move(rest));
+    return loops;
+}
+
+static std::vector<QPointF> withoutDuplicates(const std::vector<QPointF> &points, double epsilon) {
+    std::vector<QPointF> result;
+    result.reserve(points.size());
+    for (const QPointF &p : points) {
+        if (!result.empty()) {
+            QPointF d = p - result.back();
+            if (dot(d, d) <= epsilon * epsilon) continue;
+        }
+        result.push_back(p);
+    }
+    while (result.size() > 1) {
+        QPointF d = result.front() - result.back();
+        if (dot(d, d) > epsilon * epsilon) break;
+        result.pop_back();
+    }
+    return result;
+}
+
+static void validateOptions(const OffsetOptions &options) {
+    if (options.miterLimit < 1.0) {
+        throw std::invalid_argument("Предел острия должен быть не меньше 1. Передано: " +
+                                    std::to_string(options.miterLimit));
+    }
+
+    if (options.arcTolerance <= 0.0) {
+        throw std::invalid_argument("Допуск дуги должен быть положительным. Передано: " +
+                                    std::to_string(options.arcTolerance));
+    }
+}
+
+std::vector<std::vector<QPointF>> offsetPolygon(const std::vector<QPointF> &polygon, double distance,
+                                                const OffsetOptions &options) {
+    validateOptions(options);
+
+    std::vector<std::vector<QPointF>> result;
+
+    QRectF bounds = boundingRectOf(polygon);
+    const double epsilon = 1e-12 * std::max({1.0, bounds.width(), bounds.height()});
+
+    std::vector<QPointF> source = withoutDuplicates(polygon, epsilon);
+    if (source.size() < 3) return result;
+
+    double area = signedArea(source);
+    if (std::abs(area) <= epsilon * epsilon) return result;
+    if (area < 0.0) std::reverse(source.begin(), source.end());
+
+    if (std::abs(distance) <= epsilon) {
+        result.push_back(std::move(source));
+        return result;
+    }
+
+    // Сгущения вершин (у точек возврата сердца, у мелко разбитых кривых)
+    // дают в десятки раз больше самопересечений, чем вершин. Соседние вершины
+    // ближе 1% расстояния объединяются, а расстояние увеличивается на
+    // столько же, чтобы зазор от исходного контура не уменьшился.
+    const double merge = 0.01 * std::abs(distance);
+    std::vector<QPointF> thinned = withoutDuplicates(source, merge);
+    if (thinned.size() >= 3 && thinned.size() < source.size()) {
+        source = std::move(thinned);
+        distance += distance > 0.0 ? merge : -merge;
+    }
+
+    std::vector<QPointF> raw = withoutDuplicates(rawOffset(source, distance, options), epsilon);
+    if (raw.size() < 3) return result;
+
+    // Результат — граница области, которую сырой контур обходит
+    // положительное число раз. Петли разреза не пересекаются, поэтому
+    // вдоль каждой из них число оборотов снаружи постоянно: петля входит
+    // в границу, если она положительная, а сразу слева от неё контур
+    // обходит точку ровно один раз. Вывернутые участки у вогнутых углов
+    // и перекрытия соседних частей отбрасываются этим же правилом.
+    const double probeShift = 1e-7 * std::max({1.0, bounds.width(), bounds.height()});
+
+    SegmentGrid grid(raw);
+    std::vector<std::pair<double, std::vector<QPointF>>> kept;
+    for (std::vector<QPointF> &loop : splitLoops(raw, grid)) {
+        loop = withoutDuplicates(loop, epsilon);
+        if (loop.size() < 3) continue;
+
+        double loopArea = signedArea(loop);
+        if (loopArea <= epsilon * std::abs(distance)) continue;
+
+        // Точка чуть левее середины самого длинного ребра петли
+        size_t longest = 0;
+        double longestLength = 0.0;
+        for (size_t i = 0; i < loop.size(); ++i) {
+            QPointF edge = loop[(i + 1) % loop.size()] - loop[i];
+            double length = std::sqrt(dot(edge, edge));
+            if (length > longestLength) {
+                longestLength = length;
+                longest = i;
+            }
+        }
+        const QPointF &a = loop[longest];
+        const QPointF &b = loop[(longest + 1) % loop.size()];
+        QPointF left = QPointF(a.y() - b.y(), b.x() - a.x()) / longestLength;
+        QPointF probe = (a + b) * 0.5 + left * std::min(probeShift, 0.25 * longestLength);
+
+        if (grid.winding(probe) == 1) kept.emplace_back(loopArea, std::move(loop));
+    }
+
+    // Части внутри заполненных отверстий уже покрыты внешним контуром
+    std::sort(kept.begin(), kept.end(), [](const auto &l, const auto &r) { return l.first > r.first; });
+    for (size_t i = 0; i < kept.size(); ++i) {
+        const std::vector<QPointF> &loop = kept[i].second;
+        QPointF probe = 0.5 * (loop[0] + loop[1]);
+
+        bool nested = false;
+        for (const std::vector<QPointF> &outer : result) {
+            if (containsPoint(outer, probe)) {
+                nested = true;
+                break;
+            }
+        }
+        if (!nested) result.push_back(loop);
+    }
+
+    return result;
+}
+
+std::vector<std::unique_ptr<Shape>> offsetShape(const Shape &shape, double distance,
+                                                const OffsetOptions &options) {
+    std::vector<std::unique_ptr<Shape>> result;
+
+    if (const Circle *circle = dynamic_cast<const Circle*>(&shape)) {
+        validateOptions(options);
+        double radius = circle->getRadius() + distance;
+        if (radius > 0.0) {
+            result.push_back(std::make_unique<Circle>(circle->getCenterX(), circle->getCenterY(), radius));
+        }
+        return result;
+    }
+
+    for (std::vector<QPointF> &contour : offsetPolygon(shape.outline(), distance, options)) {
+        result.push_back(std::make_unique<Polygon>(contour));
+    }
+    return result;
+}
+
+std::vector<std::vector<std::unique_ptr<Shape>>> offsetScene(const std::vector<const Shape*> &shapes,
+                                                             double distance,
+                                                             const OffsetOptions &options) {
+    validateOptions(options);
+
+    std::vector<std::vector<std::unique_ptr<Shape>>> result(shapes.size());
+    parallelFor(shapes.size(), [&](size_t i) {
+        result[i] = offsetShape(*shapes[i], distance, options);
+    });
+    return result;
+}
@@ -0,0 +1,47 @@
+#ifndef OFFSET_H
+#define OFFSET_H
+
+#include "shape.h"
+#include <memory>
+#include <vector>
+
+// Смещение контура на расстояние distance: > 0 — наружу (припуск,
+// ширина реза), < 0 — внутрь. Результат не подходит к исходному контуру
+// ближе чем на |distance|: скругления строятся описанной ломаной, а
+// острые углы срезаются не ближе miterLimit * |distance| от вершины.
+//
+// Сырой смещённый контур строится за O(n), самопересечения ищутся по
+// равномерной сетке, поэтому время почти линейно по числу вершин.
+// Внутреннее смещение может распасться на несколько частей или исчезнуть.
+// Отверстия, возникающие при наружном смещении вогнутых фигур (например,
+// сомкнувшиеся лучи звезды), заполняются.
+
+enum class OffsetJoin {
+    Miter,
+    Round
+};
+
+struct OffsetOptions {
+    OffsetJoin join = OffsetJoin::Miter;
+    // Наибольшая длина острия в долях |distance|, не меньше 1
+    double miterLimit = 2.0;
+    // Наибольшее отклонение ломаной скругления от дуги
+    double arcTolerance = 0.25;
+};
+
+// Контуры результата в положительном обходе
+std::vector<std::vector<QPointF>> offsetPolygon(const std::vector<QPointF> &polygon, double distance,
+                                                const OffsetOptions &options = OffsetOptions());
+
+// Круг смещается точно — радиус меняется на distance; остальные фигуры
+// смещаются по контуру outline() и возвращаются многоугольниками.
+std::vector<std::unique_ptr<Shape>> offsetShape(const Shape &shape, double distance,
+                                                const OffsetOptions &options = OffsetOptions());
+
+// Фигуры сцены смещаются параллельно; результат i соответствует shapes[i].
+// Фигуры должны быть материализованы (Shape::materialize).
+std::vector<std::vector<std::unique_ptr<Shape>>> offsetScene(const std::vector<const Shape*> &shapes,
+                                                             double distance,
+                                                             const OffsetOptions &options = OffsetOptions());
+
+#endif // OFFSET_H
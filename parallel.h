@@ -0,0 +1,61 @@
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+inline unsigned defaultThreadCount() {
+    unsigned count = std::thread::hardware_concurrency();
+    return count > 0 ? count : 1;
+}
+
+// Вызывает fn(i) для i в [0, count) на нескольких потоках.
+// Индексы раздаются динамически, первое исключение пробрасывается вызывающему.
+template <typename Function>
+void parallelFor(size_t count, Function &&fn, unsigned threadCount = 0) {
+    if (count == 0) return;
+
+    if (threadCount == 0) threadCount = defaultThreadCount();
+    threadCount = static_cast<unsigned>(std::min<size_t>(threadCount, count));
+
+    if (threadCount == 1) {
+        for (size_t i = 0; i < count; ++i) fn(i);
+        return;
+    }
+
+    std::atomic<size_t> next(0);
+    std::exception_ptr error;
+    std::mutex errorMutex;
+
+    auto worker = [&]() {
+        try {
+            for (size_t i = next++; i < count; i = next++) {
+                fn(i);
+            }
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(errorMutex);
+            if (!error) error = std::current_exception();
+            next = count;
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(threadCount - 1);
+    for (unsigned t = 1; t < threadCount; ++t) {
+        threads.emplace_back(worker);
+    }
+    worker();
+
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+
+    if (error) std::rethrow_exception(error);
+}
+
+#endif // PARALLEL_H
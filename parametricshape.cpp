@@ -0,0 +1,257 @@
+#include "parametricshape.h"
+#include "instrumentation.h"
+#include "star.h"
+#include "hexagon.h"
+#include "square.h"
+#include "rhombus.h"
+#include <cmath>
+#include <stdexcept>
+
+static double directionDeg(const QPointF &from, const QPointF &to) {
+    return std::atan2(to.y() - from.y(), to.x() - from.x()) * 180.0 / M_PI;
+}
+
+ParametricShape::ParametricShape(Kind k, double x, double y, double s, double param, int p, double angleDeg)
+    : Shape(x, y), rotation(angleDeg), size(s), parameter(param), points(p), kind(k)
+{
+    if (size <= 0.0) {
+        throw std::invalid_argument(
+            "Размер фигуры должен быть положительным. Передано: " +
+            std::to_string(size)
+            );
+    }
+}
+
+ParametricShape ParametricShape::star(double x, double y, int p, double outerR, double innerR, double angleDeg) {
+    if (p < 3) {
+        throw std::invalid_argument("Звезда должна иметь минимум 3 конца. Передано: " + std::to_string(p));
+    }
+
+    if (innerR <= 0.0 || innerR >= outerR) {
+        throw std::invalid_argument(
+            "Внутренний радиус должен быть в диапазоне (0, внешний радиус). "
+            "Внешний: " + std::to_string(outerR) + ", внутренний: " + std::to_string(innerR)
+            );
+    }
+
+    return ParametricShape(StarKind, x, y, outerR, innerR / outerR, p, angleDeg);
+}
+
+ParametricShape ParametricShape::hexagon(double x, double y, double s, double angleDeg) {
+    return ParametricShape(HexagonKind, x, y, s, 0.0, 6, angleDeg);
+}
+
+ParametricShape ParametricShape::square(double x, double y, double s, double angleDeg) {
+    return ParametricShape(SquareKind, x, y, s, 0.0, 4, angleDeg);
+}
+
+ParametricShape ParametricShape::rhombus(double x, double y, double side, double acuteAngle, double angleDeg) {
+    if (acuteAngle <= 0.0 || acuteAngle >= 90.0) {
+        throw std::invalid_argument(
+            "Острый угол ромба должен быть в диапазоне (0°, 90°). Передано: " +
+            std::to_string(acuteAngle) + "°"
+            );
+    }
+
+    return ParametricShape(RhombusKind, x, y, side, acuteAngle, 4, angleDeg);
+}
+
+ParametricShape ParametricShape::fromStar(const Star &star) {
+    QPointF c = star.centerOfMass();
+    return ParametricShape::star(c.x(), c.y(), star.getPointsCount(),
+                                 star.getOuterRadius(), star.getInnerRadius(),
+                                 directionDeg(c, star.vertex(0)) + 90.0);
+}
+
+ParametricShape ParametricShape::fromHexagon(const Hexagon &hexagon) {
+    QPointF c = hexagon.centerOfMass();
+    return ParametricShape::hexagon(c.x(), c.y(), hexagon.getSide(),
+                                    directionDeg(c, hexagon.vertex(0)));
+}
+
+ParametricShape ParametricShape::fromSquare(const Square &square) {
+    QPointF c = square.centerOfMass();
+    return ParametricShape::square(c.x(), c.y(), square.getSide(),
+                                   directionDeg(square.vertex(0), square.vertex(1)));
+}
+
+ParametricShape ParametricShape::fromRhombus(const Rhombus &rhombus) {
+    QPointF c = rhombus.centerOfMass();
+    return ParametricShape::rhombus(c.x(), c.y(), rhombus.getSide(), rhombus.getAcuteAngle(),
+                                    directionDeg(rhombus.vertex(0), rhombus.vertex(2)));
+}
+
+double ParametricShape::area() const {
+    SHAPE_PROBE_SHAPE(Area);
+    switch (kind) {
+    case StarKind:
+        return points * size * (size * parameter) * std::sin(M_PI / points);
+    case HexagonKind:
+        return (3.0 * std::sqrt(3.0) / 2.0) * size * size;
+    case SquareKind:
+        return size * size;
+    case RhombusKind:
+        return size * size * std::sin(parameter * M_PI / 180.0);
+    }
+    return 0.0;
+}
+
+double ParametricShape::perimeter() const {
+    SHAPE_PROBE_SHAPE(Perimeter);
+    switch (kind) {
+    case StarKind: {
+        double inner = size * parameter;
+        double edge = std::sqrt(size * size + inner * inner
+                                - 2.0 * size * inner * std::cos(M_PI / points));
+        return 2.0 * points * edge;
+    }
+    case HexagonKind:
+        return 6.0 * size;
+    case SquareKind:
+    case RhombusKind:
+        return 4.0 * size;
+    }
+    return 0.0;
+}
+
+void ParametricShape::move(double dx, double dy) {
+    SHAPE_PROBE_SHAPE(Move);
+    centerX += dx;
+    centerY += dy;
+}
+
+void ParametricShape::rotate(double angleDeg, double originX, double originY) {
+    SHAPE_PROBE_SHAPE(Rotate);
+    QPointF newCenter = rotatePoint(QPointF(centerX, centerY), angleDeg, originX, originY);
+    centerX = newCenter.x();
+    centerY = newCenter.y();
+
+    rotation = std::fmod(rotation + angleDeg, 360.0);
+}
+
+void ParametricShape::scale(double factor, double originX, double originY) {
+    SHAPE_PROBE_SHAPE(Scale);
+    if (factor <= 0.0) {
+        throw std::invalid_argument(
+            "Коэффициент масштабирования должен быть положительным. "
+            "Передано: " + std::to_string(factor)
+            );
+    }
+
+    QPointF newCenter = scalePoint(QPointF(centerX, centerY), factor, originX, originY);
+    centerX = newCenter.x();
+    centerY = newCenter.y();
+
+    size *= factor;
+}
+
+size_t ParametricShape::vertexCount() const {
+    return (kind == StarKind) ? static_cast<size_t>(2 * points) : static_cast<size_t>(points);
+}
+
+QPointF ParametricShape::localVertex(size_t index) const {
+    switch (kind) {
+    case StarKind: {
+        double angle = -M_PI_2 + static_cast<double>(index) * M_PI / points;
+        double radius = (index % 2 == 0) ? size : size * parameter;
+        return QPointF(radius * std::cos(angle), radius * std::sin(angle));
+    }
+    case HexagonKind: {
+        double angle = -static_cast<double>(index) * M_PI / 3.0;
+        return QPointF(size * std::cos(angle), size * std::sin(angle));
+    }
+    case SquareKind: {
+        static const double signs[4][2] = { {-1, -1}, {1, -1}, {1, 1}, {-1, 1} };
+        return QPointF(signs[index][0] * size / 2.0, signs[index][1] * size / 2.0);
+    }
+    case RhombusKind: {
+        double halfAngle = parameter * M_PI / 360.0;
+        double hx = size * std::cos(halfAngle);
+        double hy = size * std::sin(halfAngle);
+        static const double signs[4][2] = { {-1, 0}, {0, -1}, {1, 0}, {0, 1} };
+        return QPointF(signs[index][0] * hx, signs[index][1] * hy);
+    }
+    }
+    return QPointF();
+}
+
+QPointF ParametricShape::vertex(size_t index) const {
+    if (index >= vertexCount()) {
+        throw std::out_of_range(
+            "Индекс вершины выходит за границы. Запрошено: " +
+            std::to_string(index) + ", максимум: " + std::to_string(vertexCount() - 1)
+            );
+    }
+
+    QPointF local = localVertex(index);
+    return rotatePoint(QPointF(centerX + local.x(), centerY + local.y()), rotation, centerX, centerY);
+}
+
+std::vector<QPointF> ParametricShape::vertices() const {
+    const size_t n = vertexCount();
+    const double angleRad = rotation * M_PI / 180.0;
+    const double cosA = std::cos(angleRad);
+    const double sinA = std::sin(angleRad);
+
+    std::vector<QPointF> verts;
+    verts.reserve(n);
+
+    for (size_t i = 0; i < n; ++i) {
+        QPointF local = localVertex(i);
+        verts.emplace_back(centerX + local.x() * cosA - local.y() * sinA,
+                           centerY + local.x() * sinA + local.y() * cosA);
+    }
+
+    return verts;
+}
+
+void ParametricShape::draw(QPainter &painter) const {
+    SHAPE_PROBE_SHAPE(Draw);
+    painter.setRenderHint(QPainter::Antialiasing, true);
+
+    painter.setPen(QPen(Qt::darkGreen, 2));
+    painter.setBrush(QColor(144, 238, 144, 100));
+
+    QPolygonF polygon;
+    for (const QPointF &v : vertices()) {
+        polygon << v;
+    }
+    painter.drawPolygon(polygon);
+
+    painter.setPen(QPen(Qt::red, 3));
+    painter.setBrush(Qt::red);
+    painter.drawEllipse(QPointF(centerX, centerY), 5, 5);
+}
+
+QRectF ParametricShape::boundingRect() const {
+    return boundingRectOf(vertices());
+}
+
+std::vector<QPointF> ParametricShape::outline() const {
+    return vertices();
+}
+
+std::unique_ptr<Polygon> ParametricShape::toPolygon() const {
+    std::unique_ptr<Polygon> result;
+
+    switch (kind) {
+    case StarKind:
+        result = std::make_unique<Star>(centerX, centerY, points, size, size * parameter);
+        break;
+    case HexagonKind:
+        result = std::make_unique<Hexagon>(centerX, centerY, size);
+        break;
+    case SquareKind:
+        result = std::make_unique<Square>(centerX, centerY, size);
+        break;
+    case RhombusKind:
+        result = std::make_unique<Rhombus>(centerX, centerY, size, parameter);
+        break;
+    }
+
+    if (std::abs(rotation) > 1e-12) {
+        result->rotate(rotation, centerX, centerY);
+    }
+
+    return result;
+}
@@ -0,0 +1,72 @@
+#ifndef PARAMETRICSHAPE_H
+#define PARAMETRICSHAPE_H
+
+#include "shape.h"
+#include <memory>
+#include <vector>
+
+class Polygon;
+class Star;
+class Hexagon;
+class Square;
+class Rhombus;
+
+// Компактное представление правильных фигур: центр, поворот, размер и
+// параметр формы вместо массива вершин. Вершины строятся только по запросу,
+// преобразования выполняются за O(1).
+class ParametricShape : public Shape {
+public:
+    enum Kind : unsigned char {
+        StarKind,
+        HexagonKind,
+        SquareKind,
+        RhombusKind
+    };
+
+private:
+    double rotation;   // градусы
+    double size;       // внешний радиус звезды, сторона шестиугольника/квадрата/ромба
+    double parameter;  // отношение внутреннего радиуса к внешнему (звезда), острый угол (ромб)
+    int points;
+    Kind kind;
+
+    ParametricShape(Kind k, double x, double y, double s, double param, int p, double angleDeg);
+
+    QPointF localVertex(size_t index) const;
+
+public:
+    static ParametricShape star(double x, double y, int p, double outerR, double innerR, double angleDeg = 0.0);
+    static ParametricShape hexagon(double x, double y, double s, double angleDeg = 0.0);
+    static ParametricShape square(double x, double y, double s, double angleDeg = 0.0);
+    static ParametricShape rhombus(double x, double y, double side, double acuteAngle, double angleDeg = 0.0);
+
+    static ParametricShape fromStar(const Star &star);
+    static ParametricShape fromHexagon(const Hexagon &hexagon);
+    static ParametricShape fromSquare(const Square &square);
+    static ParametricShape fromRhombus(const Rhombus &rhombus);
+
+    double area() const override;
+    double perimeter() const override;
+    void move(double dx, double dy) override;
+    void rotate(double angleDeg, double originX, double originY) override;
+    void scale(double factor, double originX, double originY) override;
+    void draw(QPainter &painter) const override;
+    QRectF boundingRect() const override;
+    std::vector<QPointF> outline() const override;
+    std::unique_ptr<Shape> clone() const override { return std::make_unique<ParametricShape>(*this); }
+
+    Kind getKind() const { return kind; }
+    int getPointsCount() const { return points; }
+    double getRotation() const { return rotation; }
+    double getSize() const { return size; }
+    double getParameter() const { return parameter; }
+
+    size_t vertexCount() const;
+    QPointF vertex(size_t index) const;
+    std::vector<QPointF> vertices() const;
+
+    // Полноценный объект соответствующего класса (Star, Hexagon, Square, Rhombus)
+    std::unique_ptr<Polygon> toPolygon() const;
+};
+
+#endif // PARAMETRICSHAPE_H
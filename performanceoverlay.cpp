@@ -0,0 +1,181 @@
+#include "performanceoverlay.h"
+#include <QPainter>
+#include <algorithm>
+
+static const int kPanelWidth = 320;
+static const int kPadding = 8;
+static const int kLineHeight = 15;
+static const int kHistogramHeight = 36;
+static const int kSparklineHeight = 14;
+static const size_t kHistory = 120;
+
+RollingSeries::RollingSeries(size_t capacity)
+    : values(capacity, 0.0)
+{
+}
+
+void RollingSeries::push(double value) {
+    values[next] = value;
+    next = (next + 1) % values.size();
+    count = std::min(count + 1, values.size());
+}
+
+double RollingSeries::at(size_t index) const {
+    size_t oldest = (next + values.size() - count) % values.size();
+    return values[(oldest + index) % values.size()];
+}
+
+double RollingSeries::last() const {
+    return count == 0 ? 0.0 : at(count - 1);
+}
+
+double RollingSeries::mean() const {
+    if (count == 0) return 0.0;
+
+    double sum = 0.0;
+    for (size_t i = 0; i < count; ++i) sum += at(i);
+    return sum / count;
+}
+
+double RollingSeries::max() const {
+    double result = 0.0;
+    for (size_t i = 0; i < count; ++i) result = std::max(result, at(i));
+    return result;
+}
+
+double RollingSeries::percentile(double fraction) const {
+    if (count == 0) return 0.0;
+
+    std::vector<double> sorted;
+    sorted.reserve(count);
+    for (size_t i = 0; i < count; ++i) sorted.push_back(at(i));
+
+    size_t index = static_cast<size_t>(fraction * (count - 1) + 0.5);
+    std::nth_element(sorted.begin(), sorted.begin() + static_cast<std::ptrdiff_t>(index), sorted.end());
+    return sorted[index];
+}
+
+// Столбцы значений серии слева направо, от старых к новым
+static void drawHistogram(QPainter &painter, const QRectF &area, const RollingSeries &series,
+                          double scaleMax, const QColor &color) {
+    painter.fillRect(area, QColor(255, 255, 255, 30));
+    if (series.size() == 0 || scaleMax <= 0.0) return;
+
+    double barWidth = area.width() / series.capacity();
+    for (size_t i = 0; i < series.size(); ++i) {
+        double height = std::min(1.0, series.at(i) / scaleMax) * area.height();
+        painter.fillRect(QRectF(area.left() + i * barWidth, area.bottom() - height,
+                                std::max(1.0, barWidth - 1.0), height), color);
+    }
+}
+
+PerformanceOverlay::PerformanceOverlay(QWidget *parent)
+    : QWidget(parent),
+      frameMs(kHistory), shapesDrawn(kHistory), shapesCulled(kHistory),
+      vertices(kHistory), partialFrames(kHistory), redrawn(kHistory)
+{
+    setAttribute(Qt::WA_TransparentForMouseEvents);
+    updateSize();
+}
+
+void PerformanceOverlay::addFrame(const FrameStats &stats) {
+    frameMs.push(stats.renderMs);
+    shapesDrawn.push(static_cast<double>(stats.shapesDrawn));
+    shapesCulled.push(static_cast<double>(stats.shapesCulled));
+    vertices.push(static_cast<double>(stats.verticesSubmitted));
+    partialFrames.push(stats.fullRedraw ? 0.0 : 1.0);
+    redrawn.push(stats.redrawnFraction);
+
+    // Тип, впервые появившийся в середине истории, получает нули за уже
+    // показанные кадры: иначе его столбцы сдвинулись бы к левому краю
+    size_t knownTypes = drawMsByType.size();
+    for (const auto &entry : stats.drawCostByType) {
+        auto inserted = drawMsByType.emplace(entry.first, RollingSeries(kHistory));
+        if (inserted.second) {
+            for (size_t frame = 1; frame < frameMs.size(); ++frame) {
+                inserted.first->second.push(0.0);
+            }
+        }
+    }
+
+    // Типы, не рисовавшиеся в этом кадре, получают ноль, чтобы
+    // столбцы всех гистограмм соответствовали одним и тем же кадрам
+    for (auto &entry : drawMsByType) {
+        auto cost = stats.drawCostByType.find(entry.first);
+        entry.second.push(cost != stats.drawCostByType.end() ? cost->second.ms : 0.0);
+    }
+
+    if (drawMsByType.size() != knownTypes) {
+        updateSize();
+    }
+    update();
+}
+
+QString PerformanceOverlay::summary() const {
+    return QString("Кадр %1 мс (p95 %2) · фигур %3, отсечено %4 · вершин %5 · кэш кадра %6%")
+        .arg(frameMs.last(), 0, 'f', 1)
+        .arg(frameMs.percentile(0.95), 0, 'f', 1)
+        .arg(static_cast<qint64>(shapesDrawn.last()))
+        .arg(static_cast<qint64>(shapesCulled.last()))
+        .arg(static_cast<qint64>(vertices.last()))
+        .arg(partialFrames.mean() * 100.0, 0, 'f', 0);
+}
+
+void PerformanceOverlay::updateSize() {
+    int lines = 5 + static_cast<int>(drawMsByType.size());
+    int height = 2 * kPadding + lines * kLineHeight + kHistogramHeight +
+                 static_cast<int>(drawMsByType.size()) * (kSparklineHeight + 2);
+    resize(kPanelWidth, height);
+}
+
+void PerformanceOverlay::paintEvent(QPaintEvent *event) {
+    Q_UNUSED(event);
+
+    QPainter painter(this);
+    painter.fillRect(rect(), QColor(20, 20, 20, 190));
+    painter.setPen(Qt::white);
+
+    const double left = kPadding;
+    const double innerWidth = kPanelWidth - 2 * kPadding;
+    double y = kPadding;
+
+    auto text = [&](const QString &line) {
+        y += kLineHeight;
+        painter.drawText(QPointF(left, y - 3), line);
+    };
+
+    text(QString("Кадр: %1 мс  среднее %2  p95 %3  макс %4")
+             .arg(frameMs.last(), 0, 'f', 2)
+             .arg(frameMs.mean(), 0, 'f', 2)
+             .arg(frameMs.percentile(0.95), 0, 'f', 2)
+             .arg(frameMs.max(), 0, 'f', 2));
+
+    // Шкала с запасом над p95, чтобы редкие выбросы не сжимали остальное
+    double frameScale = std::max(1.0, frameMs.percentile(0.95) * 1.5);
+    drawHistogram(painter, QRectF(left, y + 2, innerWidth, kHistogramHeight - 4), frameMs,
+                  frameScale, QColor(120, 200, 255, 220));
+    y += kHistogramHeight;
+
+    text(QString("Нарисовано %1, отсечено %2")
+             .arg(static_cast<qint64>(shapesDrawn.last()))
+             .arg(static_cast<qint64>(shapesCulled.last())));
+    text(QString("Вершин передано: %1").arg(static_cast<qint64>(vertices.last())));
+    text(QString("Кадр из кэша: %1%  перерисовано площади: %2%")
+             .arg(partialFrames.mean() * 100.0, 0, 'f', 0)
+             .arg(redrawn.mean() * 100.0, 0, 'f', 0));
+    text("draw() по типам, мс за кадр:");
+
+    double typeScale = 0.0;
+    for (const auto &entry : drawMsByType) {
+        typeScale = std::max(typeScale, entry.second.max());
+    }
+
+    for (const auto &entry : drawMsByType) {
+        text(QString("  %1: %2")
+                 .arg(QString::fromStdString(entry.first))
+                 .arg(entry.second.mean(), 0, 'f', 3));
+        drawHistogram(painter, QRectF(left, y + 1, innerWidth, kSparklineHeight), entry.second,
+                      typeScale, QColor(255, 180, 90, 220));
+        y += kSparklineHeight + 2;
+    }
+}
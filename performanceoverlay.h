@@ -0,0 +1,64 @@
+#ifndef PERFORMANCEOVERLAY_H
+#define PERFORMANCEOVERLAY_H
+
+#include "renderworker.h"
+#include <QString>
+#include <QWidget>
+#include <map>
+#include <string>
+#include <vector>
+
+// Последние значения метрики в кольцевом буфере
+class RollingSeries {
+private:
+    std::vector<double> values;
+    size_t next = 0;
+    size_t count = 0;
+
+public:
+    explicit RollingSeries(size_t capacity = 120);
+
+    void push(double value);
+
+    size_t size() const { return count; }
+    size_t capacity() const { return values.size(); }
+
+    // 0 — самое старое значение
+    double at(size_t index) const;
+    double last() const;
+
+    double mean() const;
+    double max() const;
+    double percentile(double fraction) const;
+};
+
+// Полупрозрачная панель поверх холста: время кадра, нарисованные и
+// отсечённые фигуры, число вершин, повторное использование кадра и
+// стоимость draw() по типам фигур в виде гистограмм за последние кадры.
+class PerformanceOverlay : public QWidget {
+    Q_OBJECT
+
+public:
+    explicit PerformanceOverlay(QWidget *parent = nullptr);
+
+    void addFrame(const FrameStats &stats);
+
+    // Краткая строка для строки состояния
+    QString summary() const;
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+
+private:
+    RollingSeries frameMs;
+    RollingSeries shapesDrawn;
+    RollingSeries shapesCulled;
+    RollingSeries vertices;
+    RollingSeries partialFrames;
+    RollingSeries redrawn;
+    std::map<std::string, RollingSeries> drawMsByType;
+
+    void updateSize();
+};
+
+#endif // PERFORMANCEOVERLAY_H
@@ -0,0 +1,770 @@
+#include "physics.h"
+#include "circle.h"
+#include "parallel.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+static const uint32_t kWall = std::numeric_limits<uint32_t>::max();
+// Тела обрабатываются пачками по kChunk
+static const size_t kChunk = 1024;
+// Допустимое взаимопроникновение и доля, убираемая за шаг
+static const double kLinearSlop = 0.5;
+static const double kBaumgarte = 0.2;
+// Медленнее сближающиеся тела не отскакивают, а ложатся друг на друга
+static const double kRestitutionThreshold = 20.0;
+// Точка контакта, близкая к точке прошлого шага, наследует её импульсы
+static const double kWarmStartDistance = 2.0;
+
+template <typename Function>
+static void forEachChunk(size_t count, Function &&fn) {
+    parallelFor((count + kChunk - 1) / kChunk, [&](size_t chunk) {
+        const size_t end = std::min(count, (chunk + 1) * kChunk);
+        for (size_t i = chunk * kChunk; i < end; ++i) fn(i);
+    });
+}
+
+struct MassProperties {
+    double mass;
+    double inertia;
+    QPointF centroid;
+};
+
+// Масса и момент инерции относительно центра масс по контуру фигуры
+static MassProperties massProperties(const Shape &shape, double density) {
+    if (const Circle *circle = dynamic_cast<const Circle*>(&shape)) {
+        const double r = circle->getRadius();
+        const double mass = density * M_PI * r * r;
+        return {mass, 0.5 * mass * r * r, circle->centerOfMass()};
+    }
+
+    const std::vector<QPointF> points = shape.outline();
+    const QPointF origin = points.empty() ? QPointF() : points[0];
+
+    // Сумма по треугольникам (origin, a, b); координаты от первой
+    // вершины, чтобы не терять точность вдали от начала координат
+    double doubleArea = 0.0;
+    double sumX = 0.0;
+    double sumY = 0.0;
+    double sumInertia = 0.0;
+    for (size_t i = 0; i < points.size(); ++i) {
+        const QPointF a = points[i] - origin;
+        const QPointF b = points[(i + 1) % points.size()] - origin;
+        const double c = a.x() * b.y() - a.y() * b.x();
+        doubleArea += c;
+        sumX += (a.x() + b.x()) * c;
+        sumY += (a.y() + b.y()) * c;
+        sumInertia += c * (a.x() * a.x() + a.x() * b.x() + b.x() * b.x() +
+                           a.y() * a.y() + a.y() * b.y() + b.y() * b.y());
+    }
+
+    if (std::abs(doubleArea) < 1e-12) {
+        throw std::invalid_argument("Фигура нулевой площади не может быть телом");
+    }
+
+    const QPointF centroid(sumX / (3.0 * doubleArea), sumY / (3.0 * doubleArea));
+    const double mass = density * 0.5 * std::abs(doubleArea);
+    const double inertiaAtOrigin = density * std::abs(sumInertia) / 12.0;
+    const double inertia = inertiaAtOrigin - mass * (centroid.x() * centroid.x() + centroid.y() * centroid.y());
+    return {mass, inertia, centroid + origin};
+}
+
+PhysicsWorld::PhysicsWorld(const PhysicsOptions &options) : options(options) {
+    if (!(options.density > 0.0)) {
+        throw std::invalid_argument("Плотность должна быть положительной. Передано: " +
+                                    std::to_string(options.density));
+    }
+
+    if (options.restitution < 0.0 || options.restitution > 1.0) {
+        throw std::invalid_argument("Упругость должна быть в [0, 1]. Передано: " +
+                                    std::to_string(options.restitution));
+    }
+
+    if (options.friction < 0.0) {
+        throw std::invalid_argument("Трение не может быть отрицательным. Передано: " +
+                                    std::to_string(options.friction));
+    }
+
+    if (options.iterations < 1) {
+        throw std::invalid_argument("Число итераций должно быть >= 1. Передано: " +
+                                    std::to_string(options.iterations));
+    }
+}
+
+size_t PhysicsWorld::addBody(Shape *shape, bool isStatic) {
+    if (!shape) {
+        throw std::invalid_argument("Фигура тела не задана");
+    }
+
+    const MassProperties properties = massProperties(*shape, options.density);
+
+    shapes.push_back(shape);
+    x.push_back(properties.centroid.x());
+    y.push_back(properties.centroid.y());
+    angleRad.push_back(0.0);
+    vx.push_back(0.0);
+    vy.push_back(0.0);
+    omega.push_back(0.0);
+    massOf.push_back(properties.mass);
+    inertiaOf.push_back(properties.inertia);
+    invMass.push_back(isStatic ? 0.0 : 1.0 / properties.mass);
+    invInertia.push_back(isStatic ? 0.0 : 1.0 / properties.inertia);
+    syncedX.push_back(x.back());
+    syncedY.push_back(y.back());
+    syncedAngle.push_back(0.0);
+
+    const Circle *circle = dynamic_cast<const Circle*>(shape);
+    circleRadius.push_back(circle ? circle->getRadius() : 0.0);
+
+    std::vector<QPointF> hull;
+    if (!circle) {
+        std::vector<QPointF> points = shape->outline();
+        for (QPointF &p : points) p -= properties.centroid;
+        hull = convexHullOf(std::move(points));
+    }
+
+    hullStart.push_back(static_cast<uint32_t>(localX.size()));
+    hullCount.push_back(static_cast<uint32_t>(hull.size()));
+    for (size_t i = 0; i < hull.size(); ++i) {
+        const QPointF edge = hull[(i + 1) % hull.size()] - hull[i];
+        const double length = std::sqrt(edge.x() * edge.x() + edge.y() * edge.y());
+        localX.push_back(hull[i].x());
+        localY.push_back(hull[i].y());
+        // Внешняя нормаль при положительной ориентации
+        localNormalX.push_back(edge.y() / length);
+        localNormalY.push_back(-edge.x() / length);
+    }
+
+    worldX.resize(localX.size());
+    worldY.resize(localX.size());
+    normalX.resize(localX.size());
+    normalY.resize(localX.size());
+    minX.push_back(0.0);
+    minY.push_back(0.0);
+    maxX.push_back(0.0);
+    maxY.push_back(0.0);
+
+    return shapes.size() - 1;
+}
+
+void PhysicsWorld::setVelocity(size_t body, const QPointF &velocity, double angularVelocityDeg) {
+    if (invMass[body] == 0.0) return;
+    vx[body] = velocity.x();
+    vy[body] = velocity.y();
+    omega[body] = angularVelocityDeg * M_PI / 180.0;
+}
+
+double PhysicsWorld::angle(size_t body) const {
+    return angleRad[body] * 180.0 / M_PI;
+}
+
+double PhysicsWorld::angularVelocity(size_t body) const {
+    return omega[body] * 180.0 / M_PI;
+}
+
+void PhysicsWorld::updateWorldGeometry() {
+    forEachChunk(bodyCount(), [&](size_t i) {
+        if (circleRadius[i] > 0.0) {
+            minX[i] = x[i] - circleRadius[i];
+            maxX[i] = x[i] + circleRadius[i];
+            minY[i] = y[i] - circleRadius[i];
+            maxY[i] = y[i] + circleRadius[i];
+            return;
+        }
+
+        const double c = std::cos(angleRad[i]);
+        const double s = std::sin(angleRad[i]);
+        double left = std::numeric_limits<double>::infinity();
+        double right = -left;
+        double top = left;
+        double bottom = -left;
+
+        const size_t end = hullStart[i] + hullCount[i];
+        for (size_t k = hullStart[i]; k < end; ++k) {
+            worldX[k] = x[i] + c * localX[k] - s * localY[k];
+            worldY[k] = y[i] + s * localX[k] + c * localY[k];
+            normalX[k] = c * localNormalX[k] - s * localNormalY[k];
+            normalY[k] = s * localNormalX[k] + c * localNormalY[k];
+            left = std::min(left, worldX[k]);
+            right = std::max(right, worldX[k]);
+            top = std::min(top, worldY[k]);
+            bottom = std::max(bottom, worldY[k]);
+        }
+
+        minX[i] = left;
+        maxX[i] = right;
+        minY[i] = top;
+        maxY[i] = bottom;
+    });
+}
+
+// Широкая фаза: каждое тело заносится во все ячейки сетки, которые
+// задевает его прямоугольник; записи раскладываются подсчётом по
+// корзинам хэша ячейки (за линейное время, без сортировки сравнением),
+// внутри корзины тела идут по возрастанию. Разные ячейки в одной
+// корзине различаются по ключу. Пара проверяется только в ячейке
+// левого верхнего угла пересечения прямоугольников, поэтому не повторяется.
+std::vector<std::pair<uint32_t, uint32_t>> PhysicsWorld::findPairs() const {
+    struct Entry {
+        uint64_t key;
+        int32_t column;
+        int32_t row;
+        uint32_t body;
+    };
+
+    const size_t count = bodyCount();
+    double sizeSum = 0.0;
+    for (size_t i = 0; i < count; ++i) {
+        sizeSum += std::max(maxX[i] - minX[i], maxY[i] - minY[i]);
+    }
+    const double cell = std::max(1e-6, count > 0 ? sizeSum / count : 1.0);
+
+    std::vector<Entry> entries;
+    entries.reserve(4 * count);
+    for (size_t i = 0; i < count; ++i) {
+        const int column0 = static_cast<int>(std::floor(minX[i] / cell));
+        const int column1 = static_cast<int>(std::floor(maxX[i] / cell));
+        const int row0 = static_cast<int>(std::floor(minY[i] / cell));
+        const int row1 = static_cast<int>(std::floor(maxY[i] / cell));
+        for (int row = row0; row <= row1; ++row) {
+            for (int column = column0; column <= column1; ++column) {
+                const uint64_t key = (static_cast<uint64_t>(static_cast<uint32_t>(column)) << 32) |
+                                     static_cast<uint32_t>(row);
+                entries.push_back({key, column, row, static_cast<uint32_t>(i)});
+            }
+        }
+    }
+
+    // Корзин не меньше записей — степень двойки; номер корзины — старшие
+    // биты ключа, умноженного на нечётную константу (хэш Фибоначчи)
+    int bucketBits = 1;
+    while ((size_t(1) << bucketBits) < entries.size()) ++bucketBits;
+    const size_t bucketCount = size_t(1) << bucketBits;
+    auto bucketOf = [bucketBits](uint64_t key) {
+        return static_cast<size_t>((key * 0x9E3779B97F4A7C15ull) >> (64 - bucketBits));
+    };
+
+    std::vector<size_t> bucketStarts(bucketCount + 1, 0);
+    for (const Entry &entry : entries) ++bucketStarts[bucketOf(entry.key) + 1];
+    for (size_t bucket = 0; bucket < bucketCount; ++bucket) bucketStarts[bucket + 1] += bucketStarts[bucket];
+
+    std::vector<Entry> sorted(entries.size());
+    {
+        std::vector<size_t> next(bucketStarts.begin(), bucketStarts.end() - 1);
+        for (const Entry &entry : entries) sorted[next[bucketOf(entry.key)]++] = entry;
+    }
+
+    const size_t bucketsPerTask = 1024;
+    const size_t taskCount = (bucketCount + bucketsPerTask - 1) / bucketsPerTask;
+    std::vector<std::vector<std::pair<uint32_t, uint32_t>>> found(taskCount);
+
+    parallelFor(taskCount, [&](size_t task) {
+        const size_t lastBucket = std::min(bucketCount, (task + 1) * bucketsPerTask);
+        for (size_t bucket = task * bucketsPerTask; bucket < lastBucket; ++bucket) {
+            const size_t end = bucketStarts[bucket + 1];
+            for (size_t i = bucketStarts[bucket]; i < end; ++i) {
+                const uint32_t a = sorted[i].body;
+                for (size_t j = i + 1; j < end; ++j) {
+                    if (sorted[j].key != sorted[i].key) continue;
+                    const uint32_t b = sorted[j].body;
+                    if (invMass[a] == 0.0 && invMass[b] == 0.0) continue;
+                    if (minX[a] > maxX[b] || minX[b] > maxX[a] || minY[a] > maxY[b] || minY[b] > maxY[a]) continue;
+
+                    const int column = static_cast<int>(std::floor(std::max(minX[a], minX[b]) / cell));
+                    const int row = static_cast<int>(std::floor(std::max(minY[a], minY[b]) / cell));
+                    if (column != sorted[i].column || row != sorted[i].row) continue;
+
+                    found[task].emplace_back(a, b);
+                }
+            }
+        }
+    });
+
+    std::vector<std::pair<uint32_t, uint32_t>> pairs;
+    for (const auto &part : found) pairs.insert(pairs.end(), part.begin(), part.end());
+    return pairs;
+}
+
+// Оставляет часть отрезка, где n·p <= offset
+static int clipSegment(QPointF segment[2], double nx, double ny, double offset) {
+    const double d0 = nx * segment[0].x() + ny * segment[0].y() - offset;
+    const double d1 = nx * segment[1].x() + ny * segment[1].y() - offset;
+
+    QPointF clipped[2];
+    int count = 0;
+    if (d0 <= 0.0) clipped[count++] = segment[0];
+    if (d1 <= 0.0) clipped[count++] = segment[1];
+    if (d0 * d1 < 0.0) clipped[count++] = segment[0] + (segment[1] - segment[0]) * (d0 / (d0 - d1));
+
+    segment[0] = clipped[0];
+    segment[1] = clipped[1];
+    return count;
+}
+
+struct HullView {
+    const double *x;
+    const double *y;
+    const double *nx;
+    const double *ny;
+    uint32_t count;
+};
+
+// Наибольшее по сторонам a расстояние от стороны до ближайшей вершины b;
+// положительное — многоугольники не пересекаются
+static double maxSeparation(const HullView &a, const HullView &b, uint32_t &edge) {
+    double best = -std::numeric_limits<double>::infinity();
+    for (uint32_t i = 0; i < a.count; ++i) {
+        double separation = std::numeric_limits<double>::infinity();
+        for (uint32_t j = 0; j < b.count; ++j) {
+            separation = std::min(separation, a.nx[i] * (b.x[j] - a.x[i]) + a.ny[i] * (b.y[j] - a.y[i]));
+        }
+        if (separation > best) {
+            best = separation;
+            edge = i;
+        }
+    }
+    return best;
+}
+
+void PhysicsWorld::collide(uint32_t a, uint32_t b, std::vector<Contact> &out) const {
+    Contact contact = {};
+    contact.a = a;
+    contact.b = b;
+
+    auto hullOf = [&](uint32_t body) {
+        const size_t start = hullStart[body];
+        return HullView{&worldX[start], &worldY[start], &normalX[start], &normalY[start], hullCount[body]};
+    };
+
+    if (circleRadius[a] > 0.0 && circleRadius[b] > 0.0) {
+        const double dx = x[b] - x[a];
+        const double dy = y[b] - y[a];
+        const double reach = circleRadius[a] + circleRadius[b];
+        const double distance = std::sqrt(dx * dx + dy * dy);
+        if (distance >= reach) return;
+
+        contact.nx = distance > 0.0 ? dx / distance : 0.0;
+        contact.ny = distance > 0.0 ? dy / distance : 1.0;
+        contact.pointCount = 1;
+        contact.depth[0] = reach - distance;
+        contact.px[0] = x[a] + contact.nx * (circleRadius[a] - 0.5 * contact.depth[0]);
+        contact.py[0] = y[a] + contact.ny * (circleRadius[a] - 0.5 * contact.depth[0]);
+        out.push_back(contact);
+        return;
+    }
+
+    if (circleRadius[a] > 0.0 || circleRadius[b] > 0.0) {
+        // Нормаль строится от многоугольника к кругу и при необходимости разворачивается
+        const bool circleFirst = circleRadius[a] > 0.0;
+        const uint32_t polygon = circleFirst ? b : a;
+        const uint32_t circle = circleFirst ? a : b;
+        const HullView hull = hullOf(polygon);
+        const double r = circleRadius[circle];
+        const QPointF center(x[circle], y[circle]);
+
+        uint32_t edge = 0;
+        double separation = -std::numeric_limits<double>::infinity();
+        for (uint32_t i = 0; i < hull.count; ++i) {
+            const double s = hull.nx[i] * (center.x() - hull.x[i]) + hull.ny[i] * (center.y() - hull.y[i]);
+            if (s > separation) {
+                separation = s;
+                edge = i;
+            }
+        }
+        if (separation > r) return;
+
+        const uint32_t next = (edge + 1) % hull.count;
+        const QPointF v1(hull.x[edge], hull.y[edge]);
+        const QPointF v2(hull.x[next], hull.y[next]);
+
+        QPointF normal(hull.nx[edge], hull.ny[edge]);
+        QPointF surface = center - normal * separation;
+        double depth = r - separation;
+
+        if (separation > 0.0) {
+            // Центр снаружи: ближайшая точка стороны может быть её концом
+            const QPointF edgeVector = v2 - v1;
+            const double t = std::clamp(((center.x() - v1.x()) * edgeVector.x() + (center.y() - v1.y()) * edgeVector.y()) /
+                                        (edgeVector.x() * edgeVector.x() + edgeVector.y() * edgeVector.y()), 0.0, 1.0);
+            surface = v1 + edgeVector * t;
+            const QPointF d = center - surface;
+            const double distance = std::sqrt(d.x() * d.x() + d.y() * d.y());
+            if (distance >= r) return;
+            if (distance > 0.0) normal = d / distance;
+            depth = r - distance;
+        }
+
+        contact.nx = circleFirst ? -normal.x() : normal.x();
+        contact.ny = circleFirst ? -normal.y() : normal.y();
+        contact.pointCount = 1;
+        contact.depth[0] = depth;
+        contact.px[0] = surface.x() - 0.5 * depth * normal.x();
+        contact.py[0] = surface.y() - 0.5 * depth * normal.y();
+        out.push_back(contact);
+        return;
+    }
+
+    const HullView hullA = hullOf(a);
+    const HullView hullB = hullOf(b);
+    if (hullA.count < 3 || hullB.count < 3) return;
+
+    uint32_t edgeA = 0;
+    uint32_t edgeB = 0;
+    const double separationA = maxSeparation(hullA, hullB, edgeA);
+    if (separationA > 0.0) return;
+    const double separationB = maxSeparation(hullB, hullA, edgeB);
+    if (separationB > 0.0) return;
+
+    // Опорная сторона — у тела с наибольшим разделением; небольшой
+    // допуск в пользу a, чтобы выбор не дрожал между шагами
+    const bool flip = separationB > 0.98 * separationA + 0.1 * kLinearSlop;
+    const HullView &reference = flip ? hullB : hullA;
+    const HullView &incident = flip ? hullA : hullB;
+    const uint32_t edge = flip ? edgeB : edgeA;
+    const double nx = reference.nx[edge];
+    const double ny = reference.ny[edge];
+
+    uint32_t incidentEdge = 0;
+    double minDot = std::numeric_limits<double>::infinity();
+    for (uint32_t i = 0; i < incident.count; ++i) {
+        const double dot = nx * incident.nx[i] + ny * incident.ny[i];
+        if (dot < minDot) {
+            minDot = dot;
+            incidentEdge = i;
+        }
+    }
+
+    const QPointF r1(reference.x[edge], reference.y[edge]);
+    const QPointF r2(reference.x[(edge + 1) % reference.count], reference.y[(edge + 1) % reference.count]);
+    const uint32_t incidentNext = (incidentEdge + 1) % incident.count;
+    QPointF segment[2] = {QPointF(incident.x[incidentEdge], incident.y[incidentEdge]),
+                          QPointF(incident.x[incidentNext], incident.y[incidentNext])};
+
+    // Падающая сторона обрезается по торцам опорной
+    const QPointF tangent = (r2 - r1) / std::sqrt((r2 - r1).x() * (r2 - r1).x() + (r2 - r1).y() * (r2 - r1).y());
+    if (clipSegment(segment, -tangent.x(), -tangent.y(), -(tangent.x() * r1.x() + tangent.y() * r1.y())) < 2) return;
+    if (clipSegment(segment, tangent.x(), tangent.y(), tangent.x() * r2.x() + tangent.y() * r2.y()) < 2) return;
+
+    contact.nx = flip ? -nx : nx;
+    contact.ny = flip ? -ny : ny;
+    for (const QPointF &p : segment) {
+        const double separation = nx * (p.x() - r1.x()) + ny * (p.y() - r1.y());
+        if (separation > 0.0) continue;
+        const int k = contact.pointCount++;
+        contact.depth[k] = -separation;
+        contact.px[k] = p.x() - 0.5 * separation * nx;
+        contact.py[k] = p.y() - 0.5 * separation * ny;
+    }
+
+    if (contact.pointCount > 0) out.push_back(contact);
+}
+
+void PhysicsWorld::collideWalls(uint32_t body, std::vector<Contact> &out) const {
+    const QRectF &bounds = options.bounds;
+    if (minX[body] >= bounds.left() && maxX[body] <= bounds.right() &&
+        minY[body] >= bounds.top() && maxY[body] <= bounds.bottom()) {
+        return;
+    }
+
+    // Нормали стенок наружу и положения их плоскостей вдоль нормали
+    const double wallNormals[4][2] = {{-1.0, 0.0}, {1.0, 0.0}, {0.0, -1.0}, {0.0, 1.0}};
+    const double wallOffsets[4] = {-bounds.left(), bounds.right(), -bounds.top(), bounds.bottom()};
+
+    for (int wall = 0; wall < 4; ++wall) {
+        const double nx = wallNormals[wall][0];
+        const double ny = wallNormals[wall][1];
+
+        Contact contact = {};
+        contact.a = body;
+        contact.b = kWall;
+        contact.nx = nx;
+        contact.ny = ny;
+
+        if (circleRadius[body] > 0.0) {
+            const double depth = nx * x[body] + ny * y[body] + circleRadius[body] - wallOffsets[wall];
+            if (depth <= 0.0) continue;
+            contact.pointCount = 1;
+            contact.depth[0] = depth;
+            contact.px[0] = x[body] + nx * (circleRadius[body] - 0.5 * depth);
+            contact.py[0] = y[body] + ny * (circleRadius[body] - 0.5 * depth);
+            out.push_back(contact);
+            continue;
+        }
+
+        // Две самые глубокие вершины за стенкой
+        const size_t end = hullStart[body] + hullCount[body];
+        for (size_t k = hullStart[body]; k < end; ++k) {
+            const double depth = nx * worldX[k] + ny * worldY[k] - wallOffsets[wall];
+            if (depth <= 0.0) continue;
+
+            int slot = contact.pointCount;
+            if (slot == 2) {
+                slot = contact.depth[0] < contact.depth[1] ? 0 : 1;
+                if (depth <= contact.depth[slot]) continue;
+            } else {
+                ++contact.pointCount;
+            }
+            contact.depth[slot] = depth;
+            contact.px[slot] = worldX[k] - 0.5 * depth * nx;
+            contact.py[slot] = worldY[k] - 0.5 * depth * ny;
+        }
+
+        if (contact.pointCount > 0) out.push_back(contact);
+    }
+}
+
+void PhysicsWorld::prepareContacts(double dt) {
+    // Контакты прошлого шага раскладываются подсчётом по первому телу:
+    // у тела их единицы, и поиск пары просматривает только их
+    std::vector<uint32_t> previousStart(bodyCount() + 1, 0);
+    for (const Contact &previous : previousContacts) ++previousStart[previous.a + 1];
+    for (size_t i = 0; i < bodyCount(); ++i) previousStart[i + 1] += previousStart[i];
+
+    std::vector<uint32_t> previousOrder(previousContacts.size());
+    {
+        std::vector<uint32_t> next(previousStart.begin(), previousStart.end() - 1);
+        for (size_t i = 0; i < previousContacts.size(); ++i) {
+            previousOrder[next[previousContacts[i].a]++] = static_cast<uint32_t>(i);
+        }
+    }
+
+    // Контакт той же пары с той же стороны с прошлого шага
+    auto findPrevious = [&](const Contact &c) -> const Contact* {
+        for (uint32_t k = previousStart[c.a]; k < previousStart[c.a + 1]; ++k) {
+            const Contact &previous = previousContacts[previousOrder[k]];
+            if (previous.b != c.b) continue;
+            if (previous.nx * c.nx + previous.ny * c.ny > 0.95) return &previous;
+        }
+        return nullptr;
+    };
+
+    forEachChunk(contacts.size(), [&](size_t index) {
+        Contact &c = contacts[index];
+        const bool wall = c.b == kWall;
+        const double invMassA = invMass[c.a];
+        const double invInertiaA = invInertia[c.a];
+        const double invMassB = wall ? 0.0 : invMass[c.b];
+        const double invInertiaB = wall ? 0.0 : invInertia[c.b];
+        const double tx = -c.ny;
+        const double ty = c.nx;
+
+        for (int k = 0; k < c.pointCount; ++k) {
+            c.rax[k] = c.px[k] - x[c.a];
+            c.ray[k] = c.py[k] - y[c.a];
+            c.rbx[k] = wall ? 0.0 : c.px[k] - x[c.b];
+            c.rby[k] = wall ? 0.0 : c.py[k] - y[c.b];
+
+            const double rnA = c.rax[k] * c.ny - c.ray[k] * c.nx;
+            const double rnB = c.rbx[k] * c.ny - c.rby[k] * c.nx;
+            const double normalK = invMassA + invMassB + invInertiaA * rnA * rnA + invInertiaB * rnB * rnB;
+            c.normalMass[k] = normalK > 0.0 ? 1.0 / normalK : 0.0;
+
+            const double rtA = c.rax[k] * ty - c.ray[k] * tx;
+            const double rtB = c.rbx[k] * ty - c.rby[k] * tx;
+            const double tangentK = invMassA + invMassB + invInertiaA * rtA * rtA + invInertiaB * rtB * rtB;
+            c.tangentMass[k] = tangentK > 0.0 ? 1.0 / tangentK : 0.0;
+
+            double dvx = -(vx[c.a] - omega[c.a] * c.ray[k]);
+            double dvy = -(vy[c.a] + omega[c.a] * c.rax[k]);
+            if (!wall) {
+                dvx += vx[c.b] - omega[c.b] * c.rby[k];
+                dvy += vy[c.b] + omega[c.b] * c.rbx[k];
+            }
+            const double approach = dvx * c.nx + dvy * c.ny;
+
+            const double bounce = approach < -kRestitutionThreshold ? -options.restitution * approach : 0.0;
+            const double push = kBaumgarte / dt * std::max(0.0, c.depth[k] - kLinearSlop);
+            c.targetVelocity[k] = std::max(bounce, push);
+            c.normalImpulse[k] = 0.0;
+            c.tangentImpulse[k] = 0.0;
+        }
+
+        if (const Contact *previous = findPrevious(c)) {
+            for (int k = 0; k < c.pointCount; ++k) {
+                for (int j = 0; j < previous->pointCount; ++j) {
+                    const double dx = c.px[k] - previous->px[j];
+                    const double dy = c.py[k] - previous->py[j];
+                    if (dx * dx + dy * dy < kWarmStartDistance * kWarmStartDistance) {
+                        c.normalImpulse[k] = previous->normalImpulse[j];
+                        c.tangentImpulse[k] = previous->tangentImpulse[j];
+                        break;
+                    }
+                }
+            }
+        }
+    });
+}
+
+void PhysicsWorld::applyImpulse(const Contact &c, int point, double impulseX, double impulseY) {
+    if (invMass[c.a] > 0.0) {
+        vx[c.a] -= invMass[c.a] * impulseX;
+        vy[c.a] -= invMass[c.a] * impulseY;
+        omega[c.a] -= invInertia[c.a] * (c.rax[point] * impulseY - c.ray[point] * impulseX);
+    }
+    if (c.b != kWall && invMass[c.b] > 0.0) {
+        vx[c.b] += invMass[c.b] * impulseX;
+        vy[c.b] += invMass[c.b] * impulseY;
+        omega[c.b] += invInertia[c.b] * (c.rbx[point] * impulseY - c.rby[point] * impulseX);
+    }
+}
+
+void PhysicsWorld::warmStart(const Contact &c) {
+    for (int k = 0; k < c.pointCount; ++k) {
+        applyImpulse(c, k,
+                     c.normalImpulse[k] * c.nx - c.tangentImpulse[k] * c.ny,
+                     c.normalImpulse[k] * c.ny + c.tangentImpulse[k] * c.nx);
+    }
+}
+
+// Последовательные импульсы: трение, затем нормаль, с накоплением и
+// отсечением суммарного импульса. Неподвижные тела не записываются.
+void PhysicsWorld::solveContact(Contact &c) {
+    const double tx = -c.ny;
+    const double ty = c.nx;
+
+    for (int k = 0; k < c.pointCount; ++k) {
+        auto relativeVelocity = [&](double &dvx, double &dvy) {
+            dvx = -(vx[c.a] - omega[c.a] * c.ray[k]);
+            dvy = -(vy[c.a] + omega[c.a] * c.rax[k]);
+            if (c.b != kWall) {
+                dvx += vx[c.b] - omega[c.b] * c.rby[k];
+                dvy += vy[c.b] + omega[c.b] * c.rbx[k];
+            }
+        };
+
+        double dvx = 0.0;
+        double dvy = 0.0;
+        relativeVelocity(dvx, dvy);
+
+        const double limit = options.friction * c.normalImpulse[k];
+        const double tangentImpulse = std::clamp(c.tangentImpulse[k] - c.tangentMass[k] * (dvx * tx + dvy * ty),
+                                                 -limit, limit);
+        const double tangentDelta = tangentImpulse - c.tangentImpulse[k];
+        c.tangentImpulse[k] = tangentImpulse;
+        applyImpulse(c, k, tangentDelta * tx, tangentDelta * ty);
+
+        relativeVelocity(dvx, dvy);
+        const double approach = dvx * c.nx + dvy * c.ny;
+        const double normalImpulse = std::max(0.0, c.normalImpulse[k] - c.normalMass[k] * (approach - c.targetVelocity[k]));
+        const double normalDelta = normalImpulse - c.normalImpulse[k];
+        c.normalImpulse[k] = normalImpulse;
+        applyImpulse(c, k, normalDelta * c.nx, normalDelta * c.ny);
+    }
+}
+
+// Контакты делятся на вертикальные полосы по положению подвижных тел.
+// Полосы не имеют общих подвижных тел и решаются параллельно, все
+// итерации сразу; контакты через границу полос — после них, в одном потоке.
+void PhysicsWorld::solveContacts() {
+    if (contacts.empty()) return;
+
+    double left = std::numeric_limits<double>::infinity();
+    double right = -left;
+    size_t dynamicCount = 0;
+    for (size_t i = 0; i < bodyCount(); ++i) {
+        if (invMass[i] == 0.0) continue;
+        left = std::min(left, x[i]);
+        right = std::max(right, x[i]);
+        ++dynamicCount;
+    }
+
+    const size_t stripCount = std::max<size_t>(1, std::min<size_t>(4 * defaultThreadCount(), dynamicCount / 256));
+    const double stripWidth = std::max(1e-9, (right - left) / stripCount);
+    auto stripOf = [&](uint32_t body) -> long {
+        if (body == kWall || invMass[body] == 0.0) return -1;
+        return std::min<long>(static_cast<long>(stripCount) - 1, static_cast<long>((x[body] - left) / stripWidth));
+    };
+
+    std::vector<std::vector<size_t>> strips(stripCount);
+    std::vector<size_t> crossing;
+    for (size_t i = 0; i < contacts.size(); ++i) {
+        const long stripA = stripOf(contacts[i].a);
+        const long stripB = stripOf(contacts[i].b);
+        if (stripA < 0 || stripB < 0 || stripA == stripB) {
+            strips[static_cast<size_t>(std::max(stripA, stripB))].push_back(i);
+        } else {
+            crossing.push_back(i);
+        }
+    }
+
+    parallelFor(stripCount, [&](size_t strip) {
+        for (size_t index : strips[strip]) warmStart(contacts[index]);
+        for (int iteration = 0; iteration < options.iterations; ++iteration) {
+            for (size_t index : strips[strip]) solveContact(contacts[index]);
+        }
+    });
+
+    for (size_t index : crossing) warmStart(contacts[index]);
+    for (int iteration = 0; iteration < options.iterations; ++iteration) {
+        for (size_t index : crossing) solveContact(contacts[index]);
+    }
+}
+
+void PhysicsWorld::step(double dt) {
+    if (!(dt > 0.0)) {
+        throw std::invalid_argument("Шаг времени должен быть положительным. Передано: " + std::to_string(dt));
+    }
+
+    const double gravityX = options.gravity.x() * dt;
+    const double gravityY = options.gravity.y() * dt;
+    forEachChunk(bodyCount(), [&](size_t i) {
+        if (invMass[i] == 0.0) return;
+        vx[i] += gravityX;
+        vy[i] += gravityY;
+    });
+
+    updateWorldGeometry();
+
+    const std::vector<std::pair<uint32_t, uint32_t>> pairs = findPairs();
+    lastPairCount = pairs.size();
+
+    // Пачки пар, затем пачки тел для стенок; результаты склеиваются по порядку
+    const bool walls = options.bounds.width() > 0.0 && options.bounds.height() > 0.0;
+    const size_t pairTasks = (pairs.size() + kChunk - 1) / kChunk;
+    const size_t wallTasks = walls ? (bodyCount() + kChunk - 1) / kChunk : 0;
+    std::vector<std::vector<Contact>> found(pairTasks + wallTasks);
+
+    parallelFor(found.size(), [&](size_t task) {
+        if (task < pairTasks) {
+            const size_t end = std::min(pairs.size(), (task + 1) * kChunk);
+            for (size_t i = task * kChunk; i < end; ++i) collide(pairs[i].first, pairs[i].second, found[task]);
+        } else {
+            const size_t first = (task - pairTasks) * kChunk;
+            const size_t end = std::min(bodyCount(), first + kChunk);
+            for (size_t i = first; i < end; ++i) {
+                if (invMass[i] > 0.0) collideWalls(static_cast<uint32_t>(i), found[task]);
+            }
+        }
+    });
+
+    previousContacts.swap(contacts);
+    contacts.clear();
+    for (const auto &part : found) contacts.insert(contacts.end(), part.begin(), part.end());
+
+    prepareContacts(dt);
+    solveContacts();
+
+    forEachChunk(bodyCount(), [&](size_t i) {
+        x[i] += vx[i] * dt;
+        y[i] += vy[i] * dt;
+        angleRad[i] += omega[i] * dt;
+    });
+}
+
+void PhysicsWorld::syncShapes() {
+    forEachChunk(bodyCount(), [&](size_t i) {
+        if (x[i] == syncedX[i] && y[i] == syncedY[i] && angleRad[i] == syncedAngle[i]) return;
+
+        // Поворот вокруг записанного центра масс, затем перенос
+        if (angleRad[i] != syncedAngle[i]) {
+            shapes[i]->rotate((angleRad[i] - syncedAngle[i]) * 180.0 / M_PI, syncedX[i], syncedY[i]);
+        }
+        shapes[i]->move(x[i] - syncedX[i], y[i] - syncedY[i]);
+
+        syncedX[i] = x[i];
+        syncedY[i] = y[i];
+        syncedAngle[i] = angleRad[i];
+    });
+}
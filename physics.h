@@ -0,0 +1,108 @@
+#ifndef PHYSICS_H
+#define PHYSICS_H
+
+#include "shape.h"
+#include <QPointF>
+#include <QRectF>
+#include <cstdint>
+#include <vector>
+
+struct PhysicsOptions {
+    // Ось y направлена вниз, как на холсте
+    QPointF gravity = QPointF(0.0, 980.0);
+    double density = 1.0;
+    double restitution = 0.3;
+    double friction = 0.4;
+    int iterations = 8;
+    // Стенки мира; пустой прямоугольник — без стенок
+    QRectF bounds;
+};
+
+// Твёрдые тела для фигур сцены. Масса, центр масс и момент инерции
+// считаются по геометрии фигуры, столкновения — по её выпуклой оболочке
+// (круг — точно).
+//
+// Состояние тел хранится массивами по полям и интегрируется пачками.
+// Шаг: гравитация → широкая фаза (сетка по прямоугольникам) → узкая
+// (разделяющие оси) → импульсы → положения. Фигуры сцены при этом не
+// трогаются: syncShapes() переносит на них накопленные перемещения
+// и повороты, например перед отрисовкой кадра. Между вызовами
+// syncShapes() фигуры нельзя изменять снаружи.
+class PhysicsWorld {
+public:
+    explicit PhysicsWorld(const PhysicsOptions &options = PhysicsOptions());
+
+    // Фигура не копируется и должна жить дольше мира
+    size_t addBody(Shape *shape, bool isStatic = false);
+
+    void setVelocity(size_t body, const QPointF &velocity, double angularVelocityDeg = 0.0);
+
+    void step(double dt);
+
+    // Отложенная запись положений тел в фигуры
+    void syncShapes();
+
+    size_t bodyCount() const { return shapes.size(); }
+    double mass(size_t body) const { return massOf[body]; }
+    double inertia(size_t body) const { return inertiaOf[body]; }
+    QPointF position(size_t body) const { return QPointF(x[body], y[body]); }
+    double angle(size_t body) const;
+    QPointF velocity(size_t body) const { return QPointF(vx[body], vy[body]); }
+    double angularVelocity(size_t body) const;
+
+    // Итоги последнего шага
+    size_t pairCount() const { return lastPairCount; }
+    size_t contactCount() const { return contacts.size(); }
+
+private:
+    struct Contact {
+        // b — второе тело или стенка мира
+        uint32_t a, b;
+        // Нормаль от a к b
+        double nx, ny;
+        int pointCount;
+        double px[2], py[2], depth[2];
+        // Заполняется перед решением
+        double rax[2], ray[2], rbx[2], rby[2];
+        double normalMass[2], tangentMass[2], targetVelocity[2];
+        double normalImpulse[2], tangentImpulse[2];
+    };
+
+    PhysicsOptions options;
+    std::vector<Shape*> shapes;
+
+    // Состояние тел
+    std::vector<double> x, y, angleRad;
+    std::vector<double> vx, vy, omega;
+    std::vector<double> invMass, invInertia;
+    std::vector<double> massOf, inertiaOf;
+    // Радиус круга; 0 — тело-многоугольник
+    std::vector<double> circleRadius;
+
+    // Выпуклые оболочки относительно центра масс, подряд для всех тел
+    std::vector<uint32_t> hullStart, hullCount;
+    std::vector<double> localX, localY, localNormalX, localNormalY;
+    // Они же в мировых координатах на текущем шаге
+    std::vector<double> worldX, worldY, normalX, normalY;
+    std::vector<double> minX, minY, maxX, maxY;
+
+    // Положение, уже записанное в фигуру
+    std::vector<double> syncedX, syncedY, syncedAngle;
+
+    std::vector<Contact> contacts;
+    // Контакты прошлого шага: их импульсы — начальное приближение
+    std::vector<Contact> previousContacts;
+    size_t lastPairCount = 0;
+
+    void updateWorldGeometry();
+    std::vector<std::pair<uint32_t, uint32_t>> findPairs() const;
+    void collide(uint32_t a, uint32_t b, std::vector<Contact> &out) const;
+    void collideWalls(uint32_t body, std::vector<Contact> &out) const;
+    void prepareContacts(double dt);
+    void applyImpulse(const Contact &contact, int point, double impulseX, double impulseY);
+    void warmStart(const Contact &contact);
+    void solveContact(Contact &contact);
+    void solveContacts();
+};
+
+#endif // PHYSICS_H
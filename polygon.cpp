@@ -1,85 +1,74 @@
 #include "polygon.h"
+#include "geometrycore.h"
+#include "instrumentation.h"
 #include <cmath>
-#include <numeric>
 #include <QDebug>
 
 QPointF Polygon::calculateCenterOfMass() const {
+    SHAPE_PROBE_SHAPE(CenterOfMass);
     if (vertices.size() < 3) {
         return QPointF(0.0, 0.0);
     }
 
-    double totalArea = 0.0;
-    double weightedCenterX = 0.0;
-    double weightedCenterY = 0.0;
-
-    const QPointF &anchor = vertices[0];
-
-    for (size_t i = 1; i < vertices.size() - 1; ++i) {
-        const QPointF &v1 = anchor;
-        const QPointF &v2 = vertices[i];
-        const QPointF &v3 = vertices[i + 1];
-
-        double area = 0.5 * std::abs(
-                          (v2.x() - v1.x()) * (v3.y() - v1.y()) -
-                          (v3.x() - v1.x()) * (v2.y() - v1.y())
-                          );
+    return polygonCentroid(vertices.get().data(), vertices.size());
+}
 
-        if (area < 1e-10) {
-            continue;
-        }
+double Polygon::calculateArea() const {
+    return polygonArea(vertices.get().data(), vertices.size());
+}
 
+double Polygon::calculatePerimeter() const {
+    return polygonPerimeter(vertices.get().data(), vertices.size());
+}
 
-        double triCenterX = (v1.x() + v2.x() + v3.x()) / 3.0;
-        double triCenterY = (v1.y() + v2.y() + v3.y()) / 3.0;
+void Polygon::applyPendingTransform() {
+    if (pending.isIdentity()) return;
 
-        weightedCenterX += area * triCenterX;
-        weightedCenterY += area * triCenterY;
-        totalArea += area;
-    }
+    pending.mapInPlace(vertices.detach());
 
-    if (totalArea > 1e-10) {
-        weightedCenterX /= totalArea;
-        weightedCenterY /= totalArea;
-        return QPointF(weightedCenterX, weightedCenterY);
-    }
+    double factor = pending.scale();
+    if (cachedArea >= 0.0) cachedArea *= factor * factor;
+    if (cachedPerimeter >= 0.0) cachedPerimeter *= factor;
 
-    double avgX = std::accumulate(vertices.begin(), vertices.end(), 0.0,
-                                  [](double sum, const QPointF &v) { return sum + v.x(); }) / vertices.size();
-    double avgY = std::accumulate(vertices.begin(), vertices.end(), 0.0,
-                                  [](double sum, const QPointF &v) { return sum + v.y(); }) / vertices.size();
+    pending = Transform2D();
+}
 
-    return QPointF(avgX, avgY);
+std::vector<QPointF> &Polygon::mutableVertices() {
+    applyPendingTransform();
+    cachedArea = -1.0;
+    cachedPerimeter = -1.0;
+    return vertices.detach();
 }
 
-double Polygon::calculateArea() const {
-    if (vertices.size() < 3) return 0.0;
+void Polygon::setLocalFrame(const QPointF *local, size_t count, double angleDeg) {
+    vertices.assign(local, local + count);
+    pending = Transform2D(angleDeg, 1.0, centerX, centerY);
+    cachedArea = -1.0;
+    cachedPerimeter = -1.0;
+}
 
-    double area = 0.0;
-    size_t n = vertices.size();
+void Polygon::materialize() const {
+    // Вершины не трогаются: отрисовка и контур читают их через pending,
+    // а общий буфер остаётся общим
+    area();
+    perimeter();
+}
 
-    for (size_t i = 0; i < n; ++i) {
-        size_t j = (i + 1) % n;
-        area += vertices[i].x() * vertices[j].y();
-        area -= vertices[j].x() * vertices[i].y();
+double Polygon::area() const {
+    SHAPE_PROBE_SHAPE(Area);
+    if (cachedArea < 0.0) {
+        cachedArea = calculateArea();
     }
-
-    return std::abs(area) * 0.5;
+    double factor = pending.scale();
+    return cachedArea * factor * factor;
 }
 
-double Polygon::calculatePerimeter() const {
-    if (vertices.size() < 3) return 0.0;
-
-    double perimeter = 0.0;
-    size_t n = vertices.size();
-
-    for (size_t i = 0; i < n; ++i) {
-        size_t j = (i + 1) % n;
-        double dx = vertices[j].x() - vertices[i].x();
-        double dy = vertices[j].y() - vertices[i].y();
-        perimeter += std::sqrt(dx * dx + dy * dy);
+double Polygon::perimeter() const {
+    SHAPE_PROBE_SHAPE(Perimeter);
+    if (cachedPerimeter < 0.0) {
+        cachedPerimeter = calculatePerimeter();
     }
-
-    return perimeter;
+    return cachedPerimeter * pending.scale();
 }
 
 Polygon::Polygon(const std::vector<QPointF> &verts)
@@ -112,7 +101,7 @@ Polygon::Polygon(double x, double y, const std::vector<QPointF> &verts)
     double dx = x - realCM.x();
     double dy = y - realCM.y();
 
-    for (QPointF &v : vertices) {
+    for (QPointF &v : vertices.detach()) {
         v.rx() += dx;
         v.ry() += dy;
     }
@@ -121,29 +110,42 @@ Polygon::Polygon(double x, double y, const std::vector<QPointF> &verts)
     centerY = y;
 }
 
+Polygon::Polygon(const SharedVertices &shared, const Transform2D &placement)
+    : Shape(0.0, 0.0), vertices(shared), pending(placement)
+{
+    if (vertices.size() < 3) {
+        throw std::invalid_argument(
+            "Многоугольник должен иметь минимум 3 вершины. Передано: " +
+            std::to_string(vertices.size())
+            );
+    }
+
+    QPointF cm = pending.map(calculateCenterOfMass());
+    centerX = cm.x();
+    centerY = cm.y();
+}
+
 void Polygon::move(double dx, double dy) {
+    SHAPE_PROBE_SHAPE(Move);
 
     centerX += dx;
     centerY += dy;
 
-    for (QPointF &v : vertices) {
-        v.rx() += dx;
-        v.ry() += dy;
-    }
+    pending.translate(dx, dy);
 }
 
 void Polygon::rotate(double angleDeg, double originX, double originY) {
+    SHAPE_PROBE_SHAPE(Rotate);
 
     QPointF newCenter = rotatePoint(QPointF(centerX, centerY), angleDeg, originX, originY);
     centerX = newCenter.x();
     centerY = newCenter.y();
 
-    for (QPointF &v : vertices) {
-        v = rotatePoint(v, angleDeg, originX, originY);
-    }
+    pending.rotate(angleDeg, originX, originY);
 }
 
 void Polygon::scale(double factor, double originX, double originY) {
+    SHAPE_PROBE_SHAPE(Scale);
     if (factor <= 0.0) {
         throw std::invalid_argument(
             "Коэффициент масштабирования должен быть положительным. "
@@ -155,57 +157,62 @@ void Polygon::scale(double factor, double originX, double originY) {
     centerX = newCenter.x();
     centerY = newCenter.y();
 
-    for (QPointF &v : vertices) {
-        v = scalePoint(v, factor, originX, originY);
-    }
+    pending.scale(factor, originX, originY);
 }
 
 void Polygon::draw(QPainter &painter) const {
-    painter.setRenderHint(QPainter::Antialiasing, true);
-
-    painter.setPen(QPen(Qt::darkGreen, 2));
-    painter.setBrush(QColor(144, 238, 144, 100));
+    SHAPE_PROBE_SHAPE(Draw);
 
-    if (vertices.size() >= 3) {
-        QPolygonF polygon;
-        for (const QPointF &v : vertices) {
-            polygon << v;
-        }
-        painter.drawPolygon(polygon);
+    // Контур берётся преобразованной копией, общий буфер вершин не трогается
+    QPolygonF polygon;
+    for (const QPointF &v : outline()) {
+        polygon << v;
     }
+    drawPolygonShape(painter, polygon, QPointF(centerX, centerY));
+}
 
-    painter.setPen(QPen(Qt::red, 3));
-    painter.setBrush(Qt::red);
-    painter.drawEllipse(QPointF(centerX, centerY), 5, 5);
+QRectF Polygon::boundingRect() const {
+    return pending.mapBounds(vertices.get());
+}
 
-    painter.drawLine(QPointF(centerX - 8, centerY), QPointF(centerX + 8, centerY));
-    painter.drawLine(QPointF(centerX, centerY - 8), QPointF(centerX, centerY + 8));
+std::vector<QPointF> Polygon::outline() const {
+    return pending.mapped(vertices.get());
+}
 
-    painter.setPen(QPen(Qt::blue, 2));
-    painter.setBrush(Qt::blue);
-    for (const QPointF &v : vertices) {
-        painter.drawEllipse(v, 4, 4);
-    }
+void Polygon::signedDistances(const double *xs, const double *ys, double *out, size_t count) const {
+    signedDistancesToPolygon(outline(), xs, ys, out, count);
 }
 
-const QPointF& Polygon::vertex(size_t index) const {
+QPointF Polygon::vertex(size_t index) const {
     if (index >= vertices.size()) {
         throw std::out_of_range(
             "Индекс вершины выходит за границы. Запрошено: " +
             std::to_string(index) + ", максимум: " + std::to_string(vertices.size() - 1)
             );
     }
-    return vertices[index];
+    return pending.map(vertices[index]);
+}
+
+std::vector<QPointF> Polygon::getVertices() const {
+    return outline();
+}
+
+void Polygon::checkVerticesEditable() const {
+    if (verticesFollowParameters()) {
+        throw std::logic_error("Вершины этой фигуры задаются её параметрами и не меняются по отдельности");
+    }
 }
 
 void Polygon::setVertex(size_t index, const QPointF &point) {
+    SHAPE_PROBE_SHAPE(SetVertex);
+    checkVerticesEditable();
     if (index >= vertices.size()) {
         throw std::out_of_range(
             "Индекс вершины выходит за границы. Запрошено: " +
             std::to_string(index) + ", максимум: " + std::to_string(vertices.size() - 1)
             );
     }
-    vertices[index] = point;
+    mutableVertices()[index] = point;
 
     QPointF cm = calculateCenterOfMass();
     centerX = cm.x();
@@ -213,7 +220,8 @@ void Polygon::setVertex(size_t index, const QPointF &point) {
 }
 
 void Polygon::addVertex(const QPointF &point) {
-    vertices.push_back(point);
+    checkVerticesEditable();
+    mutableVertices().push_back(point);
 
     QPointF cm = calculateCenterOfMass();
     centerX = cm.x();
@@ -221,6 +229,7 @@ void Polygon::addVertex(const QPointF &point) {
 }
 
 void Polygon::removeVertex(size_t index) {
+    checkVerticesEditable();
     if (index >= vertices.size()) {
         throw std::out_of_range(
             "Индекс вершины выходит за границы. Запрошено: " +
@@ -230,7 +239,8 @@ void Polygon::removeVertex(size_t index) {
     if (vertices.size() <= 3) {
         throw std::invalid_argument("Нельзя удалить вершину — многоугольник должен иметь минимум 3 вершины");
     }
-    vertices.erase(vertices.begin() + static_cast<std::ptrdiff_t>(index));
+    std::vector<QPointF> &verts = mutableVertices();
+    verts.erase(verts.begin() + static_cast<std::ptrdiff_t>(index));
 
     QPointF cm = calculateCenterOfMass();
     centerX = cm.x();
@@ -238,13 +248,15 @@ void Polygon::removeVertex(size_t index) {
 }
 
 void Polygon::setVertices(const std::vector<QPointF> &newVertices) {
+    checkVerticesEditable();
     if (newVertices.size() < 3) {
         throw std::invalid_argument(
             "Многоугольник должен иметь минимум 3 вершины. Передано: " +
             std::to_string(newVertices.size())
             );
     }
-    vertices = newVertices;
+    pending = Transform2D();
+    mutableVertices() = newVertices;
 
     QPointF cm = calculateCenterOfMass();
     centerX = cm.x();
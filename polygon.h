@@ -2,12 +2,38 @@
 #define POLYGON_H
 
 #include "shape.h"
+#include "sharedvertices.h"
+#include "transform2d.h"
 #include <vector>
 
 
 class Polygon : public Shape {
 protected:
-    std::vector<QPointF> vertices;
+    // Вершины хранятся без отложенного преобразования pending;
+    // оно применяется к буферу только перед изменением вершин, а
+    // чтение отображает точки на лету. Копии фигуры делят буфер
+    // вершин до первого его изменения.
+    SharedVertices vertices;
+    Transform2D pending;
+
+    // Площадь и периметр вершин без pending, < 0 — не вычислены
+    mutable double cachedArea = -1.0;
+    mutable double cachedPerimeter = -1.0;
+
+    void applyPendingTransform();
+
+    // Для прямого изменения вершин в наследниках
+    std::vector<QPointF> &mutableVertices();
+
+    // Заменяет вершины на local (относительно центра, без поворота) и
+    // задаёт позу: поворот angleDeg вокруг текущего центра.
+    void setLocalFrame(const QPointF *local, size_t count, double angleDeg);
+
+    // true у фигур, вершины которых строятся из параметров (Rectangle,
+    // Square, Hexagon): поворот и масштаб перестраивают их заново, и
+    // правка отдельной вершины потерялась бы, поэтому она запрещена
+    virtual bool verticesFollowParameters() const { return false; }
+    void checkVerticesEditable() const;
 
     QPointF calculateCenterOfMass() const;
 
@@ -21,16 +47,26 @@ public:
 
     Polygon(double x, double y, const std::vector<QPointF> &verts);
 
-    double area() const override { return calculateArea(); }
-    double perimeter() const override { return calculatePerimeter(); }
+    // Общие вершины shared, размещённые преобразованием placement;
+    // буфер не копируется, пока вершины не изменят (см. GeometryLibrary)
+    Polygon(const SharedVertices &shared, const Transform2D &placement);
+
+    double area() const override;
+    double perimeter() const override;
     void move(double dx, double dy) override;
     void rotate(double angleDeg, double originX, double originY) override;
     void scale(double factor, double originX, double originY) override;
     void draw(QPainter &painter) const override;
+    QRectF boundingRect() const override;
+    std::vector<QPointF> outline() const override;
+    void signedDistances(const double *xs, const double *ys, double *out, size_t count) const override;
+    std::unique_ptr<Shape> clone() const override { return std::make_unique<Polygon>(*this); }
+    void materialize() const override;
 
+    // Вершины с учётом pending; буфер при чтении не меняется
     size_t vertexCount() const { return vertices.size(); }
-    const QPointF& vertex(size_t index) const;
-    const std::vector<QPointF>& getVertices() const { return vertices; }
+    QPointF vertex(size_t index) const;
+    std::vector<QPointF> getVertices() const;
     void setVertex(size_t index, const QPointF &point);
     void addVertex(const QPointF &point);
     void removeVertex(size_t index);
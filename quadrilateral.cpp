@@ -1,4 +1,5 @@
 #include "quadrilateral.h"
+#include <algorithm>
 #include <cmath>
 #include <stdexcept>
 #include <QDebug>
@@ -125,44 +126,12 @@ double Quadrilateral::getAngle(int vertexIndex) const {
 
 bool Quadrilateral::isConvex() const {
     if (vertexCount() != 4) return false;
-
-    for (int i = 0; i < 4; ++i) {
-        double angle = getAngle(i);
-        if (angle >= 180.0 - 1e-6) {
-            return false;
-        }
-    }
-    return true;
+    return (classify() & Convex) != 0;
 }
 
 bool Quadrilateral::isParallelogram() const {
     if (vertexCount() != 4) return false;
-
-    double side0 = getSideLength(0);
-    double side1 = getSideLength(1);
-    double side2 = getSideLength(2);
-    double side3 = getSideLength(3);
-
-    const double tolerance = 1e-6;
-    bool oppositeSidesEqual =
-        (std::abs(side0 - side2) < tolerance) &&
-        (std::abs(side1 - side3) < tolerance);
-
-    if (!oppositeSidesEqual) return false;
-
-    const QPointF &v0 = vertex(0);
-    const QPointF &v1 = vertex(1);
-    const QPointF &v2 = vertex(2);
-    const QPointF &v3 = vertex(3);
-
-    QPointF midDiag1((v0.x() + v2.x()) / 2.0, (v0.y() + v2.y()) / 2.0);
-    QPointF midDiag2((v1.x() + v3.x()) / 2.0, (v1.y() + v3.y()) / 2.0);
-
-    double dx = midDiag1.x() - midDiag2.x();
-    double dy = midDiag1.y() - midDiag2.y();
-    double dist = std::sqrt(dx * dx + dy * dy);
-
-    return dist < tolerance;
+    return (classify() & Parallelogram) != 0;
 }
 
 bool Quadrilateral::areSidesPerpendicular(int sideIndex1, int sideIndex2) const {
@@ -189,3 +158,101 @@ bool Quadrilateral::areSidesPerpendicular(int sideIndex1, int sideIndex2) const
     double cosAngle = std::abs(dot) / (len1 * len2);
     return cosAngle < 0.0175;
 }
+
+unsigned char Quadrilateral::classify(double tolerance) const {
+    if (vertexCount() != 4) return NotClassified;
+    const std::vector<QPointF> verts = getVertices();
+    return classify(verts[0], verts[1], verts[2], verts[3], tolerance);
+}
+
+unsigned char Quadrilateral::classify(const QPointF &v0, const QPointF &v1,
+                                      const QPointF &v2, const QPointF &v3,
+                                      double tolerance)
+{
+    const double ex[4] = { v1.x() - v0.x(), v2.x() - v1.x(), v3.x() - v2.x(), v0.x() - v3.x() };
+    const double ey[4] = { v1.y() - v0.y(), v2.y() - v1.y(), v3.y() - v2.y(), v0.y() - v3.y() };
+
+    double len2[4];
+    for (int i = 0; i < 4; ++i) {
+        len2[i] = ex[i] * ex[i] + ey[i] * ey[i];
+    }
+
+    unsigned char flags = NotClassified;
+    const double tol2 = tolerance * tolerance;
+
+    int positive = 0;
+    int negative = 0;
+    for (int i = 0; i < 4; ++i) {
+        int prev = (i + 3) % 4;
+        double cross = ex[prev] * ey[i] - ey[prev] * ex[i];
+
+        // |sin| поворота меньше tolerance — вершина вырождена
+        if (cross * cross <= tol2 * len2[prev] * len2[i]) {
+            positive = negative = -1;
+            break;
+        }
+        if (cross > 0.0) ++positive; else ++negative;
+    }
+    if (positive == 4 || negative == 4) {
+        flags |= Convex;
+    }
+
+    // Диагонали делятся пополам: v0 + v2 == v1 + v3
+    double mx = v0.x() + v2.x() - v1.x() - v3.x();
+    double my = v0.y() + v2.y() - v1.y() - v3.y();
+    if (mx * mx + my * my >= 4.0 * tol2) {
+        return flags;
+    }
+    flags |= Parallelogram;
+
+    double dot = ex[0] * ex[1] + ey[0] * ey[1];
+    bool rightAngles = dot * dot <= tol2 * len2[0] * len2[1];
+    bool equalSides = std::abs(len2[0] - len2[1]) <= tolerance * (len2[0] + len2[1]);
+
+    if (rightAngles) flags |= RectangleKind;
+    if (equalSides) flags |= RhombusKind;
+    if (rightAngles && equalSides) flags |= SquareKind;
+
+    return flags;
+}
+
+std::vector<unsigned char> Quadrilateral::classifyBatch(const std::vector<QPointF> &quadVertices,
+                                                        double tolerance)
+{
+    if (quadVertices.size() % 4 != 0) {
+        throw std::invalid_argument(
+            "Количество вершин должно быть кратно 4. Передано: " +
+            std::to_string(quadVertices.size())
+            );
+    }
+
+    const size_t count = quadVertices.size() / 4;
+    std::vector<unsigned char> result(count);
+
+    const QPointF *v = quadVertices.data();
+    for (size_t i = 0; i < count; ++i, v += 4) {
+        result[i] = classify(v[0], v[1], v[2], v[3], tolerance);
+    }
+
+    return result;
+}
+
+void Quadrilateral::boxSignedDistances(const QPointF &center, double angleDeg,
+                                       double halfWidth, double halfHeight,
+                                       const double *xs, const double *ys, double *out, size_t count) {
+    const double angleRad = angleDeg * M_PI / 180.0;
+    const double cosA = std::cos(angleRad);
+    const double sinA = std::sin(angleRad);
+
+    for (size_t i = 0; i < count; ++i) {
+        double dx = xs[i] - center.x();
+        double dy = ys[i] - center.y();
+        // В системе прямоугольника, отражённой в первую четверть
+        double qx = std::abs(dx * cosA + dy * sinA) - halfWidth;
+        double qy = std::abs(-dx * sinA + dy * cosA) - halfHeight;
+
+        double ox = std::max(qx, 0.0);
+        double oy = std::max(qy, 0.0);
+        out[i] = std::sqrt(ox * ox + oy * oy) + std::min(std::max(qx, qy), 0.0);
+    }
+}
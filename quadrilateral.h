@@ -6,10 +6,21 @@
 class Quadrilateral : public Polygon {
 public:
 
+    enum Classification : unsigned char {
+        NotClassified = 0,
+        Convex        = 1 << 0,
+        Parallelogram = 1 << 1,
+        RectangleKind = 1 << 2,
+        RhombusKind   = 1 << 3,
+        SquareKind    = 1 << 4
+    };
+
     Quadrilateral(const QPointF &v1, const QPointF &v2, const QPointF &v3, const QPointF &v4);
 
     Quadrilateral(double x, double y, double width, double height, double angleDeg = 0.0);
 
+    std::unique_ptr<Shape> clone() const override { return std::make_unique<Quadrilateral>(*this); }
+
     double getSideLength(int sideIndex) const;
 
     double getDiagonalLength(int diagonalIndex) const;
@@ -21,6 +32,25 @@ public:
     bool isParallelogram() const;
 
     bool areSidesPerpendicular(int sideIndex1, int sideIndex2) const;
+
+    // Все признаки за один проход: только скалярные/векторные произведения
+    // и квадраты длин, без sqrt и acos.
+    unsigned char classify(double tolerance = 1e-6) const;
+
+    static unsigned char classify(const QPointF &v0, const QPointF &v1,
+                                  const QPointF &v2, const QPointF &v3,
+                                  double tolerance = 1e-6);
+
+    // quadVertices — вершины подряд, по 4 на четырёхугольник.
+    static std::vector<unsigned char> classifyBatch(const std::vector<QPointF> &quadVertices,
+                                                    double tolerance = 1e-6);
+
+protected:
+    // Точное знаковое расстояние до прямоугольника 2·halfWidth × 2·halfHeight
+    // с центром center, повёрнутого на angleDeg
+    static void boxSignedDistances(const QPointF &center, double angleDeg,
+                                   double halfWidth, double halfHeight,
+                                   const double *xs, const double *ys, double *out, size_t count);
 };
 
 #endif // QUADRILATERAL_H
@@ -1,4 +1,5 @@
 #include "rectangle.h"
+#include "instrumentation.h"
 #include <cmath>
 #include <stdexcept>
 #include <QDebug>
@@ -47,14 +48,14 @@ Rectangle::Rectangle(const QPointF &topLeft, const QPointF &bottomRight)
     }
 }
 
-void Rectangle::updateDimensions() {
-    double side0 = getSideLength(0);
-    double side1 = getSideLength(1);
-    double side2 = getSideLength(2);
-    double side3 = getSideLength(3);
-
-    width = (side0 + side2) / 2.0;
-    height = (side1 + side3) / 2.0;
+void Rectangle::rebuildVertices() {
+    const QPointF local[4] = {
+        QPointF(-width / 2.0, -height / 2.0),
+        QPointF( width / 2.0, -height / 2.0),
+        QPointF( width / 2.0,  height / 2.0),
+        QPointF(-width / 2.0,  height / 2.0)
+    };
+    setLocalFrame(local, 4, orientation);
 }
 
 void Rectangle::setWidth(double w) {
@@ -65,15 +66,8 @@ void Rectangle::setWidth(double w) {
             );
     }
 
-    double factor = w / width;
-    double cx = centerX;
-
-    vertices[0].rx() = cx - (cx - vertices[0].x()) * factor;
-    vertices[1].rx() = cx + (vertices[1].x() - cx) * factor;
-    vertices[2].rx() = cx + (vertices[2].x() - cx) * factor;
-    vertices[3].rx() = cx - (cx - vertices[3].x()) * factor;
-
     width = w;
+    rebuildVertices();
 }
 
 void Rectangle::setHeight(double h) {
@@ -84,27 +78,27 @@ void Rectangle::setHeight(double h) {
             );
     }
 
-    double factor = h / height;
-    double cy = centerY;
-
-    vertices[0].ry() = cy - (cy - vertices[0].y()) * factor;
-    vertices[1].ry() = cy - (cy - vertices[1].y()) * factor;
-    vertices[2].ry() = cy + (vertices[2].y() - cy) * factor;
-    vertices[3].ry() = cy + (vertices[3].y() - cy) * factor;
-
     height = h;
+    rebuildVertices();
 }
 
 void Rectangle::move(double dx, double dy) {
+    SHAPE_PROBE_SHAPE(Move);
     Quadrilateral::move(dx, dy);
 }
 
 void Rectangle::rotate(double angleDeg, double originX, double originY) {
-    Quadrilateral::rotate(angleDeg, originX, originY);
-    updateDimensions();
+    SHAPE_PROBE_SHAPE(Rotate);
+    QPointF newCenter = rotatePoint(QPointF(centerX, centerY), angleDeg, originX, originY);
+    centerX = newCenter.x();
+    centerY = newCenter.y();
+
+    orientation = std::fmod(orientation + angleDeg, 360.0);
+    rebuildVertices();
 }
 
 void Rectangle::scale(double factor, double originX, double originY) {
+    SHAPE_PROBE_SHAPE(Scale);
     if (factor <= 0.0) {
         throw std::invalid_argument(
             "Коэффициент масштабирования должен быть положительным. "
@@ -112,16 +106,19 @@ void Rectangle::scale(double factor, double originX, double originY) {
             );
     }
 
-    Quadrilateral::scale(factor, originX, originY);
+    QPointF newCenter = scalePoint(QPointF(centerX, centerY), factor, originX, originY);
+    centerX = newCenter.x();
+    centerY = newCenter.y();
+
     width *= factor;
     height *= factor;
+    rebuildVertices();
 }
 
 std::vector<QPointF> Rectangle::getCorners() const {
-    return {
-        vertices[0],
-        vertices[1],
-        vertices[2],
-        vertices[3]
-    };
+    return outline();
+}
+
+void Rectangle::signedDistances(const double *xs, const double *ys, double *out, size_t count) const {
+    boxSignedDistances(QPointF(centerX, centerY), orientation, width / 2.0, height / 2.0, xs, ys, out, count);
 }
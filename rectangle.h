@@ -7,15 +7,24 @@ class Rectangle : public Quadrilateral {
 private:
     double width;
     double height;
+    double orientation = 0.0;
 
-    void updateDimensions();
+    // Вершины строятся заново из width, height, orientation и центра,
+    // поэтому повороты не накапливают погрешность
+    void rebuildVertices();
+
+protected:
+    bool verticesFollowParameters() const override { return true; }
 
 public:
     Rectangle(double x, double y, double w, double h);
     Rectangle(const QPointF &topLeft, const QPointF &bottomRight);
 
+    std::unique_ptr<Shape> clone() const override { return std::make_unique<Rectangle>(*this); }
+
     double getWidth() const { return width; }
     double getHeight() const { return height; }
+    double getOrientation() const { return orientation; }
 
     void setWidth(double w);
     void setHeight(double h);
@@ -23,6 +32,7 @@ public:
     void move(double dx, double dy) override;
     void rotate(double angleDeg, double originX, double originY) override;
     void scale(double factor, double originX, double originY) override;
+    void signedDistances(const double *xs, const double *ys, double *out, size_t count) const override;
 
     double area() const override { return width * height; }
     double perimeter() const override { return 2.0 * (width + height); }
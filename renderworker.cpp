@@ -0,0 +1,231 @@
+#include "renderworker.h"
+#include "heart.h"
+#include "instrumentation.h"
+#include "parametricshape.h"
+#include "polygon.h"
+#include <QElapsedTimer>
+#include <QMetaObject>
+#include <QPainter>
+#include <QRegion>
+#include <algorithm>
+#include <utility>
+#include <typeinfo>
+
+// Запас на толщину пера и маркеры при отсечении по видимой области
+static const double kCullMargin = 10.0;
+
+// Вершины, которые фигура передаёт QPainter; окружность рисуется
+// эллипсом и вершин не передаёт
+static size_t submittedVertices(const Shape &shape) {
+    if (const Polygon *polygon = dynamic_cast<const Polygon*>(&shape)) {
+        return polygon->vertexCount();
+    }
+    if (const Heart *heart = dynamic_cast<const Heart*>(&shape)) {
+        return static_cast<size_t>(heart->getResolution());
+    }
+    if (const ParametricShape *compact = dynamic_cast<const ParametricShape*>(&shape)) {
+        return compact->vertexCount();
+    }
+    return 0;
+}
+
+// Грязные прямоугольники запроса в пикселях кадра
+static QRegion dirtyRegion(const RenderRequest &request) {
+    QRegion region;
+    for (const QRectF &rect : request.dirtyRects) {
+        region += rect.translated(request.offset).toAlignedRect();
+    }
+    return region;
+}
+
+// Замеряет draw() каждой фигуры и копит стоимость по типам
+class DrawMeter {
+public:
+    explicit DrawMeter(FrameStats &frameStats) : stats(frameStats) {}
+
+    void draw(const Shape &shape, QPainter &painter) {
+        timer.start();
+        shape.draw(painter);
+        double ms = timer.nsecsElapsed() / 1e6;
+
+        FrameStats::TypeCost &cost = costs[&typeid(shape)];
+        ++cost.count;
+        cost.ms += ms;
+
+        ++stats.shapesDrawn;
+        stats.verticesSubmitted += submittedVertices(shape);
+    }
+
+    ~DrawMeter() {
+        for (const auto &entry : costs) {
+            FrameStats::TypeCost &cost = stats.drawCostByType[Instrumentation::typeName(*entry.first)];
+            cost.count += entry.second.count;
+            cost.ms += entry.second.ms;
+        }
+    }
+
+private:
+    FrameStats &stats;
+    QElapsedTimer timer;
+    std::map<const std::type_info*, FrameStats::TypeCost> costs;
+};
+
+RenderWorker::RenderWorker(QObject *parent)
+    : QObject(parent)
+{
+}
+
+quint64 RenderWorker::submit(const RenderRequest &request) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    pending = request;
+    hasPending = true;
+    quint64 requestGeneration = ++generation;
+
+    if (!scheduled) {
+        scheduled = true;
+        QMetaObject::invokeMethod(this, [this]() { processPending(); }, Qt::QueuedConnection);
+    }
+
+    return requestGeneration;
+}
+
+void RenderWorker::cancel() {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    pending = RenderRequest();
+    hasPending = false;
+    ++generation;
+}
+
+void RenderWorker::processPending() {
+    RenderRequest request;
+    quint64 requestGeneration;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        scheduled = false;
+        if (!hasPending) return;
+
+        request = std::move(pending);
+        pending = RenderRequest();
+        hasPending = false;
+        requestGeneration = generation;
+    }
+
+    if (request.size.isEmpty() || !request.scene) return;
+
+    FrameStats stats;
+    stats.fullRedraw = request.fullRedraw;
+    QElapsedTimer frameTimer;
+    frameTimer.start();
+
+    if (!request.fullRedraw) {
+        if (!cacheValid || cachedFrame.size() != request.size || cachedOffset != request.offset) {
+            emit fullRedrawRequired();
+            return;
+        }
+
+        if (backFrame.size() != cachedFrame.size()) {
+            backFrame = QImage(cachedFrame.size(), QImage::Format_ARGB32_Premultiplied);
+            staleRegion = QRegion(backFrame.rect());
+        }
+
+        // Второй буфер догоняет показанный кадр только в отставших
+        // пикселях, а не целиком
+        if (!staleRegion.isEmpty()) {
+            QPainter painter(&backFrame);
+            painter.setCompositionMode(QPainter::CompositionMode_Source);
+            painter.setClipRegion(staleRegion);
+            painter.drawImage(0, 0, cachedFrame);
+        }
+
+        // Прерванная частичная перерисовка оставляет грязные области
+        // недорисованными; следующий запрос их повторно включает.
+        // В обоих исходах буферы расходятся ровно в грязных областях
+        const bool finished = renderDirty(request, requestGeneration, backFrame, stats);
+        staleRegion = dirtyRegion(request).intersected(backFrame.rect());
+        if (finished) {
+            std::swap(cachedFrame, backFrame);
+            stats.renderMs = frameTimer.nsecsElapsed() / 1e6;
+            emit frameReady(cachedFrame, request.offset, requestGeneration, stats);
+        }
+        return;
+    }
+
+    // GUI держит показанный кадр, а не второй буфер: его память
+    // используется повторно
+    if (backFrame.size() != request.size) {
+        backFrame = QImage(request.size, QImage::Format_ARGB32_Premultiplied);
+    }
+    if (render(request, requestGeneration, backFrame, stats)) {
+        std::swap(cachedFrame, backFrame);
+        staleRegion = QRegion(backFrame.rect());
+        cachedOffset = request.offset;
+        cacheValid = true;
+        stats.renderMs = frameTimer.nsecsElapsed() / 1e6;
+        emit frameReady(cachedFrame, request.offset, requestGeneration, stats);
+    } else {
+        cacheValid = false;
+    }
+}
+
+bool RenderWorker::render(const RenderRequest &request, quint64 requestGeneration, QImage &target,
+                          FrameStats &stats) const {
+    target.fill(Qt::white);
+
+    QPainter painter(&target);
+    painter.translate(request.offset);
+
+    // Видимая область в координатах сцены
+    QRectF view(-request.offset.x(), -request.offset.y(), request.size.width(), request.size.height());
+    view.adjust(-kCullMargin, -kCullMargin, kCullMargin, kCullMargin);
+
+    DrawMeter meter(stats);
+    const SceneSnapshot &scene = *request.scene;
+    for (size_t i = 0; i < scene.size(); ++i) {
+        if (generation != requestGeneration) {
+            return false;
+        }
+
+        const Shape &shape = scene.at(i);
+        if (!view.intersects(shape.boundingRect())) {
+            ++stats.shapesCulled;
+            continue;
+        }
+        meter.draw(shape, painter);
+    }
+
+    return true;
+}
+
+bool RenderWorker::renderDirty(const RenderRequest &request, quint64 requestGeneration, QImage &target,
+                               FrameStats &stats) const {
+    const QRegion region = dirtyRegion(request);
+    double dirtyArea = 0.0;
+    for (const QRectF &rect : request.dirtyRects) {
+        QRect visible = rect.translated(request.offset).toAlignedRect().intersected(target.rect());
+        dirtyArea += static_cast<double>(visible.width()) * visible.height();
+    }
+
+    double frameArea = static_cast<double>(target.width()) * target.height();
+    stats.redrawnFraction = frameArea > 0.0 ? std::min(1.0, dirtyArea / frameArea) : 0.0;
+    stats.shapesCulled = request.scene->size() - request.indices.size();
+
+    if (region.isEmpty()) return true;
+
+    QPainter painter(&target);
+    painter.setClipRegion(region);
+    painter.fillRect(target.rect(), Qt::white);
+    painter.translate(request.offset);
+
+    DrawMeter meter(stats);
+    for (size_t index : request.indices) {
+        if (generation != requestGeneration) {
+            return false;
+        }
+        meter.draw(request.scene->at(index), painter);
+    }
+
+    return true;
+}
@@ -0,0 +1,95 @@
+#ifndef RENDERWORKER_H
+#define RENDERWORKER_H
+
+#include "scenestore.h"
+#include <QImage>
+#include <QMetaType>
+#include <QObject>
+#include <QRegion>
+#include <QSize>
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+struct RenderRequest {
+    std::shared_ptr<const SceneSnapshot> scene;
+    QSize size;
+    QPointF offset;
+
+    // При частичной перерисовке рисуются только фигуры с индексами
+    // indices, пересекающие dirtyRects (в координатах сцены)
+    bool fullRedraw = true;
+    std::vector<QRectF> dirtyRects;
+    std::vector<size_t> indices;
+};
+
+// Измерения одного кадра для оверлея производительности
+struct FrameStats {
+    double renderMs = 0.0;
+    bool fullRedraw = true;
+
+    size_t shapesDrawn = 0;
+    // Вне видимой области или вне грязных прямоугольников
+    size_t shapesCulled = 0;
+    size_t verticesSubmitted = 0;
+
+    // Доля площади кадра, которую пришлось перерисовать
+    double redrawnFraction = 1.0;
+
+    struct TypeCost {
+        size_t count = 0;
+        double ms = 0.0;
+    };
+    std::map<std::string, TypeCost> drawCostByType;
+};
+
+Q_DECLARE_METATYPE(FrameStats)
+
+// Рисует сцену в заднем буфере QImage в своём потоке. Новый запрос
+// заменяет ожидающий и прерывает текущую отрисовку, поэтому частые
+// изменения сцены не накапливаются в очереди. Последний кадр хранится,
+// и частичный запрос перерисовывает в нём только грязные области.
+class RenderWorker : public QObject {
+    Q_OBJECT
+
+public:
+    explicit RenderWorker(QObject *parent = nullptr);
+
+    // Потокобезопасно; возвращает номер поколения запроса
+    quint64 submit(const RenderRequest &request);
+
+    void cancel();
+
+signals:
+    void frameReady(const QImage &frame, const QPointF &offset, quint64 generation, const FrameStats &stats);
+
+    // Частичный запрос пришёл, а сохранённого кадра нет или он не подходит
+    void fullRedrawRequired();
+
+private:
+    std::mutex mutex;
+    RenderRequest pending;
+    bool hasPending = false;
+    bool scheduled = false;
+    std::atomic<quint64> generation{0};
+
+    // Используется только в потоке отрисовки. Показанный кадр
+    // cachedFrame остаётся общим с GUI, поэтому рисовать в нём нельзя:
+    // QPainter скопировал бы весь кадр. Частичная перерисовка идёт во
+    // второй буфер backFrame, после чего буферы меняются местами;
+    // staleRegion — пиксели, в которых backFrame отстаёт от cachedFrame
+    QImage cachedFrame;
+    QImage backFrame;
+    QRegion staleRegion;
+    QPointF cachedOffset;
+    bool cacheValid = false;
+
+    void processPending();
+    bool render(const RenderRequest &request, quint64 requestGeneration, QImage &target, FrameStats &stats) const;
+    bool renderDirty(const RenderRequest &request, quint64 requestGeneration, QImage &target, FrameStats &stats) const;
+};
+
+#endif // RENDERWORKER_H
@@ -1,4 +1,6 @@
 #include "rhombus.h"
+#include "instrumentation.h"
+#include <algorithm>
 #include <cmath>
 #include <stdexcept>
 #include <QDebug>
@@ -115,25 +117,29 @@ void Rhombus::setAcuteAngle(double angle) {
     double cx = centerX;
     double cy = centerY;
     double currentSide = sideLength;
+    std::vector<QPointF> &verts = mutableVertices();
 
-    vertices[0] = QPointF(cx - currentSide * std::cos(angle * M_PI / 360.0), cy);
-    vertices[1] = QPointF(cx, cy - currentSide * std::sin(angle * M_PI / 360.0));
-    vertices[2] = QPointF(cx + currentSide * std::cos(angle * M_PI / 360.0), cy);
-    vertices[3] = QPointF(cx, cy + currentSide * std::sin(angle * M_PI / 360.0));
+    verts[0] = QPointF(cx - currentSide * std::cos(angle * M_PI / 360.0), cy);
+    verts[1] = QPointF(cx, cy - currentSide * std::sin(angle * M_PI / 360.0));
+    verts[2] = QPointF(cx + currentSide * std::cos(angle * M_PI / 360.0), cy);
+    verts[3] = QPointF(cx, cy + currentSide * std::sin(angle * M_PI / 360.0));
 
     acuteAngle = angle;
 }
 
 void Rhombus::move(double dx, double dy) {
+    SHAPE_PROBE_SHAPE(Move);
     Quadrilateral::move(dx, dy);
 }
 
 void Rhombus::rotate(double angleDeg, double originX, double originY) {
+    SHAPE_PROBE_SHAPE(Rotate);
     Quadrilateral::rotate(angleDeg, originX, originY);
     updateParameters();
 }
 
 void Rhombus::scale(double factor, double originX, double originY) {
+    SHAPE_PROBE_SHAPE(Scale);
     if (factor <= 0.0) {
         throw std::invalid_argument(
             "Коэффициент масштабирования должен быть положительным. "
@@ -146,5 +152,39 @@ void Rhombus::scale(double factor, double originX, double originY) {
 }
 
 double Rhombus::area() const {
+    SHAPE_PROBE_SHAPE(Area);
     return (getDiagonal1() * getDiagonal2()) / 2.0;
 }
+
+void Rhombus::signedDistances(const double *xs, const double *ys, double *out, size_t count) const {
+    // Оси ромба — его диагонали: v0–v2 и v1–v3
+    const QPointF &v0 = vertex(0);
+    const QPointF &v1 = vertex(1);
+    const QPointF &v2 = vertex(2);
+    const QPointF &v3 = vertex(3);
+    const QPointF center = (v0 + v2) / 2.0;
+
+    const double a = distanceBetweenPoints(v0, v2) / 2.0;
+    const double b = distanceBetweenPoints(v1, v3) / 2.0;
+    const double ux = (v2.x() - v0.x()) / (2.0 * a);
+    const double uy = (v2.y() - v0.y()) / (2.0 * a);
+    const double wx = (v3.x() - v1.x()) / (2.0 * b);
+    const double wy = (v3.y() - v1.y()) / (2.0 * b);
+    const double edgeLengthSquared = a * a + b * b;
+
+    for (size_t i = 0; i < count; ++i) {
+        double dx = xs[i] - center.x();
+        double dy = ys[i] - center.y();
+        // После отражения в первую четверть ближайшая точка границы
+        // лежит на стороне от (a, 0) до (0, b)
+        double px = std::abs(dx * ux + dy * uy);
+        double py = std::abs(dx * wx + dy * wy);
+
+        double t = std::clamp(((px - a) * -a + py * b) / edgeLengthSquared, 0.0, 1.0);
+        double ex = px - a * (1.0 - t);
+        double ey = py - b * t;
+        double distance = std::sqrt(ex * ex + ey * ey);
+
+        out[i] = px * b + py * a - a * b > 0.0 ? distance : -distance;
+    }
+}
@@ -14,6 +14,8 @@ public:
     Rhombus(double x, double y, double side, double angle = 60.0);
     Rhombus(double x, double y, double diag1, double diag2, bool useDiagonals);
 
+    std::unique_ptr<Shape> clone() const override { return std::make_unique<Rhombus>(*this); }
+
     double getSide() const { return sideLength; }
     double getAcuteAngle() const { return acuteAngle; }
     double getObtuseAngle() const { return 180.0 - acuteAngle; }
@@ -26,6 +28,7 @@ public:
     void move(double dx, double dy) override;
     void rotate(double angleDeg, double originX, double originY) override;
     void scale(double factor, double originX, double originY) override;
+    void signedDistances(const double *xs, const double *ys, double *out, size_t count) const override;
 
     double area() const override;
     double perimeter() const override { return 4.0 * sideLength; }
@@ -0,0 +1,55 @@
+#include "scenecanvas.h"
+#include <QMouseEvent>
+#include <QPainter>
+
+SceneCanvas::SceneCanvas(QWidget *parent)
+    : QWidget(parent)
+{
+    setAttribute(Qt::WA_OpaquePaintEvent);
+}
+
+void SceneCanvas::presentFrame(const QImage &frame, const QPointF &frameOffset) {
+    frontBuffer = frame;
+    frontOffset = frameOffset;
+    update();
+}
+
+void SceneCanvas::paintEvent(QPaintEvent *event) {
+    Q_UNUSED(event);
+
+    QPainter painter(this);
+    painter.fillRect(rect(), Qt::white);
+
+    if (!frontBuffer.isNull()) {
+        painter.drawImage(offset - frontOffset, frontBuffer);
+    }
+}
+
+void SceneCanvas::resizeEvent(QResizeEvent *event) {
+    QWidget::resizeEvent(event);
+    emit viewChanged();
+}
+
+void SceneCanvas::mousePressEvent(QMouseEvent *event) {
+    if (event->button() == Qt::LeftButton) {
+        dragging = true;
+        lastMousePos = event->pos();
+    }
+}
+
+void SceneCanvas::mouseMoveEvent(QMouseEvent *event) {
+    if (!dragging) return;
+
+    QPointF delta = QPointF(event->pos()) - lastMousePos;
+    lastMousePos = event->pos();
+    offset += delta;
+
+    update();
+    emit viewChanged();
+}
+
+void SceneCanvas::mouseReleaseEvent(QMouseEvent *event) {
+    if (event->button() == Qt::LeftButton) {
+        dragging = false;
+    }
+}
@@ -0,0 +1,37 @@
+#ifndef SCENECANVAS_H
+#define SCENECANVAS_H
+
+#include <QImage>
+#include <QWidget>
+
+// Показывает последний готовый кадр (передний буфер). Пока новый кадр
+// рисуется в фоне, при панорамировании старый кадр просто сдвигается.
+class SceneCanvas : public QWidget {
+    Q_OBJECT
+
+public:
+    explicit SceneCanvas(QWidget *parent = nullptr);
+
+    QPointF viewOffset() const { return offset; }
+
+    void presentFrame(const QImage &frame, const QPointF &frameOffset);
+
+signals:
+    void viewChanged();
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+    void resizeEvent(QResizeEvent *event) override;
+    void mousePressEvent(QMouseEvent *event) override;
+    void mouseMoveEvent(QMouseEvent *event) override;
+    void mouseReleaseEvent(QMouseEvent *event) override;
+
+private:
+    QImage frontBuffer;
+    QPointF frontOffset;
+    QPointF offset;
+    QPointF lastMousePos;
+    bool dragging = false;
+};
+
+#endif // SCENECANVAS_H
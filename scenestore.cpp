@@ -0,0 +1,196 @@
+#include "scenestore.h"
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+const Shape &SceneSnapshot::at(size_t index) const {
+    if (index >= count) {
+        throw std::out_of_range(
+            "Индекс фигуры выходит за границы. Запрошено: " + std::to_string(index)
+            );
+    }
+    return *(*chunks[index / kChunkSize])[index % kChunkSize];
+}
+
+std::shared_ptr<const Shape> SceneSnapshot::shared(size_t index) const {
+    if (index >= count) {
+        throw std::out_of_range(
+            "Индекс фигуры выходит за границы. Запрошено: " + std::to_string(index)
+            );
+    }
+    return (*chunks[index / kChunkSize])[index % kChunkSize];
+}
+
+SceneStore::SceneStore()
+    : published(std::make_shared<SceneSnapshot>())
+{
+    current.store(published.get());
+}
+
+SceneStore::~SceneStore() = default;
+
+size_t SceneStore::acquireSlot() const {
+    // Подсказка на поток: повторные чтения обычно попадают в тот же слот
+    thread_local size_t hint = std::hash<std::thread::id>()(std::this_thread::get_id());
+
+    for (;;) {
+        for (size_t i = 0; i < kMaxReaders; ++i) {
+            size_t index = (hint + i) % kMaxReaders;
+            ReaderSlot &slot = readerSlots[index];
+
+            bool expected = false;
+            if (!slot.busy.load(std::memory_order_relaxed) &&
+                slot.busy.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+                hint = index;
+                return index;
+            }
+        }
+        std::this_thread::yield();
+    }
+}
+
+SceneStore::ReadGuard::ReadGuard(const SceneStore &store)
+    : owner(store), slot(store.acquireSlot())
+{
+    // Эпоха записывается до чтения указателя: редактор, не увидевший
+    // эту запись, уже заменил указатель, и старая версия сюда не попадёт
+    owner.readerSlots[slot].epoch.store(owner.globalEpoch.load());
+    current = owner.current.load();
+}
+
+SceneStore::ReadGuard::~ReadGuard() {
+    owner.readerSlots[slot].epoch.store(0, std::memory_order_release);
+    owner.readerSlots[slot].busy.store(false, std::memory_order_release);
+}
+
+SceneStore::Transaction::Transaction(SceneStore &store)
+    : owner(store), lock(store.writerMutex),
+      draft(std::make_shared<SceneSnapshot>())
+{
+    const SceneSnapshot &base = *owner.published;
+    draft->chunks = base.chunks;
+    draft->count = base.count;
+    draft->number = base.number + 1;
+    ownChunks.assign(draft->chunks.size(), false);
+}
+
+SceneSnapshot::Chunk &SceneStore::Transaction::writableChunk(size_t chunkIndex) {
+    if (!ownChunks[chunkIndex]) {
+        draft->chunks[chunkIndex] = std::make_shared<SceneSnapshot::Chunk>(*draft->chunks[chunkIndex]);
+        ownChunks[chunkIndex] = true;
+    }
+    return *draft->chunks[chunkIndex];
+}
+
+size_t SceneStore::Transaction::add(std::unique_ptr<Shape> shape) {
+    if (!draft) {
+        throw std::logic_error("Транзакция уже завершена");
+    }
+
+    shape->materialize();
+
+    size_t index = draft->count;
+    if (index % SceneSnapshot::kChunkSize == 0) {
+        auto chunk = std::make_shared<SceneSnapshot::Chunk>();
+        chunk->reserve(SceneSnapshot::kChunkSize);
+        draft->chunks.push_back(std::move(chunk));
+        ownChunks.push_back(true);
+    }
+
+    writableChunk(index / SceneSnapshot::kChunkSize).push_back(std::move(shape));
+    ++draft->count;
+    return index;
+}
+
+void SceneStore::Transaction::replace(size_t index, std::unique_ptr<Shape> shape) {
+    if (!draft) {
+        throw std::logic_error("Транзакция уже завершена");
+    }
+    if (index >= draft->count) {
+        throw std::out_of_range(
+            "Индекс фигуры выходит за границы. Запрошено: " + std::to_string(index)
+            );
+    }
+
+    shape->materialize();
+    writableChunk(index / SceneSnapshot::kChunkSize)[index % SceneSnapshot::kChunkSize] = std::move(shape);
+}
+
+void SceneStore::Transaction::edit(size_t index, const std::function<void(Shape&)> &fn) {
+    if (!draft) {
+        throw std::logic_error("Транзакция уже завершена");
+    }
+
+    std::unique_ptr<Shape> copy = at(index).clone();
+    fn(*copy);
+    replace(index, std::move(copy));
+}
+
+void SceneStore::Transaction::clear() {
+    if (!draft) {
+        throw std::logic_error("Транзакция уже завершена");
+    }
+
+    draft->chunks.clear();
+    draft->count = 0;
+    ownChunks.clear();
+}
+
+void SceneStore::Transaction::commit() {
+    if (!draft) {
+        throw std::logic_error("Транзакция уже завершена");
+    }
+
+    owner.publish(std::move(draft));
+    draft.reset();
+    lock.unlock();
+}
+
+std::shared_ptr<const SceneSnapshot> SceneStore::snapshot() const {
+    return read().retain();
+}
+
+size_t SceneStore::add(std::unique_ptr<Shape> shape) {
+    Transaction transaction(*this);
+    size_t index = transaction.add(std::move(shape));
+    transaction.commit();
+    return index;
+}
+
+void SceneStore::edit(size_t index, const std::function<void(Shape&)> &fn) {
+    Transaction transaction(*this);
+    transaction.edit(index, fn);
+    transaction.commit();
+}
+
+void SceneStore::publish(std::shared_ptr<SceneSnapshot> next) {
+    current.store(next.get());
+
+    // Читатели с эпохой не меньше этой взяли указатель уже после замены
+    uint64_t epoch = globalEpoch.fetch_add(1) + 1;
+    retired.push_back({std::move(published), epoch});
+    published = std::move(next);
+
+    collectRetired();
+}
+
+void SceneStore::collect() {
+    std::lock_guard<std::mutex> lock(writerMutex);
+    collectRetired();
+}
+
+void SceneStore::collectRetired() {
+    uint64_t oldestActive = UINT64_MAX;
+    for (const ReaderSlot &slot : readerSlots) {
+        uint64_t epoch = slot.epoch.load();
+        if (epoch != 0 && epoch < oldestActive) {
+            oldestActive = epoch;
+        }
+    }
+
+    retired.erase(std::remove_if(retired.begin(), retired.end(),
+                                 [oldestActive](const Retired &entry) { return entry.epoch <= oldestActive; }),
+                  retired.end());
+}
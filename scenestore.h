@@ -0,0 +1,141 @@
+#ifndef SCENESTORE_H
+#define SCENESTORE_H
+
+#include "shape.h"
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// Неизменяемая версия сцены. Фигуры хранятся блоками по kChunkSize;
+// новая версия копирует только блоки с изменёнными фигурами, остальные
+// блоки и сами фигуры общие с предыдущей версией.
+class SceneSnapshot : public std::enable_shared_from_this<SceneSnapshot> {
+public:
+    static const size_t kChunkSize = 64;
+
+    size_t size() const { return count; }
+    uint64_t version() const { return number; }
+
+    const Shape &at(size_t index) const;
+    std::shared_ptr<const Shape> shared(size_t index) const;
+
+private:
+    friend class SceneStore;
+
+    using Chunk = std::vector<std::shared_ptr<const Shape>>;
+
+    std::vector<std::shared_ptr<Chunk>> chunks;
+    size_t count = 0;
+    uint64_t number = 0;
+};
+
+// Сцена для одного потока-редактора и многих потоков-читателей.
+// Читатели берут текущую версию через ReadGuard без блокировок:
+// поток отмечает эпоху в своём слоте и читает атомарный указатель.
+// Редактор собирает новую версию в Transaction и публикует её одной
+// атомарной заменой; старые версии освобождаются, когда все
+// читатели, которые могли их видеть, вышли из своих эпох.
+class SceneStore {
+public:
+    // Число одновременно активных ReadGuard; сверх него читатель ждёт слот
+    static const size_t kMaxReaders = 128;
+
+    SceneStore();
+    ~SceneStore();
+
+    SceneStore(const SceneStore&) = delete;
+    SceneStore &operator=(const SceneStore&) = delete;
+
+    class ReadGuard {
+    public:
+        explicit ReadGuard(const SceneStore &store);
+        ~ReadGuard();
+
+        ReadGuard(const ReadGuard&) = delete;
+        ReadGuard &operator=(const ReadGuard&) = delete;
+
+        const SceneSnapshot &operator*() const { return *current; }
+        const SceneSnapshot *operator->() const { return current; }
+
+        // Продлевает жизнь версии за пределы охраны (например, для
+        // передачи в другой поток)
+        std::shared_ptr<const SceneSnapshot> retain() const { return current->shared_from_this(); }
+
+    private:
+        const SceneStore &owner;
+        size_t slot;
+        const SceneSnapshot *current;
+    };
+
+    // Правки накапливаются в черновике и становятся видны читателям
+    // только после commit(). Пока транзакция открыта, другие редакторы ждут.
+    class Transaction {
+    public:
+        explicit Transaction(SceneStore &store);
+
+        Transaction(const Transaction&) = delete;
+        Transaction &operator=(const Transaction&) = delete;
+
+        size_t size() const { return draft->count; }
+        const Shape &at(size_t index) const { return draft->at(index); }
+
+        size_t add(std::unique_ptr<Shape> shape);
+        void replace(size_t index, std::unique_ptr<Shape> shape);
+
+        // Изменяет копию фигуры; опубликованная фигура не меняется
+        void edit(size_t index, const std::function<void(Shape&)> &fn);
+
+        void clear();
+
+        void commit();
+
+    private:
+        SceneStore &owner;
+        std::unique_lock<std::mutex> lock;
+        std::shared_ptr<SceneSnapshot> draft;
+        std::vector<bool> ownChunks;
+
+        SceneSnapshot::Chunk &writableChunk(size_t chunkIndex);
+    };
+
+    ReadGuard read() const { return ReadGuard(*this); }
+
+    // Текущая версия с владением; то же, что read().retain(), и так же
+    // не ждёт открытых транзакций
+    std::shared_ptr<const SceneSnapshot> snapshot() const;
+
+    size_t add(std::unique_ptr<Shape> shape);
+    void edit(size_t index, const std::function<void(Shape&)> &fn);
+
+    // Освобождает версии, которые больше не может видеть ни один читатель
+    void collect();
+
+private:
+    struct alignas(64) ReaderSlot {
+        std::atomic<bool> busy{false};
+        // 0 — читатель не активен
+        std::atomic<uint64_t> epoch{0};
+    };
+
+    struct Retired {
+        std::shared_ptr<SceneSnapshot> snapshot;
+        uint64_t epoch;
+    };
+
+    mutable ReaderSlot readerSlots[kMaxReaders];
+    std::atomic<uint64_t> globalEpoch{1};
+    std::atomic<const SceneSnapshot*> current{nullptr};
+
+    mutable std::mutex writerMutex;
+    std::shared_ptr<SceneSnapshot> published;
+    std::vector<Retired> retired;
+
+    size_t acquireSlot() const;
+    void publish(std::shared_ptr<SceneSnapshot> next);
+    void collectRetired();
+};
+
+#endif // SCENESTORE_H
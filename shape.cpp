@@ -1,22 +1,17 @@
 #include "shape.h"
+#include "geometrycore.h"
+#include "instrumentation.h"
+#include <algorithm>
 #include <cmath>
+#include <limits>
 
 QPointF rotatePoint(const QPointF &point, double angleDeg, double originX, double originY) {
-    double angleRad = angleDeg * M_PI / 180.0;
-
-    double dx = point.x() - originX;
-    double dy = point.y() - originY;
-
-    double cosA = std::cos(angleRad);
-    double sinA = std::sin(angleRad);
-
-    double newX = originX + dx * cosA - dy * sinA;
-    double newY = originY + dx * sinA + dy * cosA;
-
-    return QPointF(newX, newY);
+    SHAPE_PROBE(RotatePoint);
+    return rotatedPoint(point, angleDeg, originX, originY);
 }
 
 QPointF scalePoint(const QPointF &point, double factor, double originX, double originY) {
+    SHAPE_PROBE(ScalePoint);
     if (factor <= 0.0) {
         throw std::invalid_argument(
             "Коэффициент масштабирования должен быть положительным. "
@@ -24,13 +19,7 @@ QPointF scalePoint(const QPointF &point, double factor, double originX, double o
             );
     }
 
-    double dx = point.x() - originX;
-    double dy = point.y() - originY;
-
-    double newX = originX + dx * factor;
-    double newY = originY + dy * factor;
-
-    return QPointF(newX, newY);
+    return scaledPoint(point, factor, originX, originY);
 }
 
 double distanceBetweenPoints(const QPointF &p1, const QPointF &p2) {
@@ -38,3 +27,132 @@ double distanceBetweenPoints(const QPointF &p1, const QPointF &p2) {
     double dy = p2.y() - p1.y();
     return std::sqrt(dx * dx + dy * dy);
 }
+
+QRectF boundingRectOf(const std::vector<QPointF> &points) {
+    if (points.empty()) return QRectF();
+
+    double minX = points[0].x();
+    double maxX = minX;
+    double minY = points[0].y();
+    double maxY = minY;
+
+    for (const QPointF &p : points) {
+        minX = std::min(minX, p.x());
+        maxX = std::max(maxX, p.x());
+        minY = std::min(minY, p.y());
+        maxY = std::max(maxY, p.y());
+    }
+
+    return QRectF(minX, minY, maxX - minX, maxY - minY);
+}
+
+std::vector<QPointF> convexHullOf(std::vector<QPointF> points) {
+    auto cross = [](const QPointF &o, const QPointF &a, const QPointF &b) {
+        return (a.x() - o.x()) * (b.y() - o.y()) - (a.y() - o.y()) * (b.x() - o.x());
+    };
+
+    // Монотонная цепочка: нижняя и верхняя половины по отсортированным точкам
+    std::sort(points.begin(), points.end(), [](const QPointF &a, const QPointF &b) {
+        return a.x() < b.x() || (a.x() == b.x() && a.y() < b.y());
+    });
+
+    std::vector<QPointF> hull(2 * points.size());
+    size_t k = 0;
+    for (size_t i = 0; i < points.size(); ++i) {
+        while (k >= 2 && cross(hull[k - 2], hull[k - 1], points[i]) <= 0.0) --k;
+        hull[k++] = points[i];
+    }
+    for (size_t i = points.size() - 1, lower = k + 1; i-- > 0;) {
+        while (k >= lower && cross(hull[k - 2], hull[k - 1], points[i]) <= 0.0) --k;
+        hull[k++] = points[i];
+    }
+
+    hull.resize(k > 1 ? k - 1 : k);
+    return hull;
+}
+
+double Shape::signedDistance(const QPointF &point) const {
+    double x = point.x();
+    double y = point.y();
+    double result = 0.0;
+    signedDistances(&x, &y, &result, 1);
+    return result;
+}
+
+void drawPolygonShape(QPainter &painter, const QPolygonF &polygon, const QPointF &center) {
+    painter.setRenderHint(QPainter::Antialiasing, true);
+
+    painter.setPen(QPen(Qt::darkGreen, 2));
+    painter.setBrush(QColor(144, 238, 144, 100));
+    if (polygon.size() >= 3) {
+        painter.drawPolygon(polygon);
+    }
+
+    painter.setPen(QPen(Qt::red, 3));
+    painter.setBrush(Qt::red);
+    painter.drawEllipse(center, 5, 5);
+
+    painter.drawLine(QPointF(center.x() - 8, center.y()), QPointF(center.x() + 8, center.y()));
+    painter.drawLine(QPointF(center.x(), center.y() - 8), QPointF(center.x(), center.y() + 8));
+
+    painter.setPen(QPen(Qt::blue, 2));
+    painter.setBrush(Qt::blue);
+    for (const QPointF &v : polygon) {
+        painter.drawEllipse(v, 4, 4);
+    }
+}
+
+void Shape::signedDistances(const double *xs, const double *ys, double *out, size_t count) const {
+    signedDistancesToPolygon(outline(), xs, ys, out, count);
+}
+
+void signedDistancesToPolygon(const std::vector<QPointF> &polygon,
+                              const double *xs, const double *ys, double *out, size_t count) {
+    const size_t n = polygon.size();
+    if (n == 0) {
+        std::fill(out, out + count, std::numeric_limits<double>::infinity());
+        return;
+    }
+
+    // Точки идут блоками: внешний цикл по рёбрам, внутренний — по точкам
+    // блока без ветвлений, и компилятор векторизует его
+    const size_t kBlock = 256;
+    double best[kBlock];
+    unsigned char inside[kBlock];
+
+    for (size_t first = 0; first < count; first += kBlock) {
+        const size_t m = std::min(kBlock, count - first);
+        const double *x = xs + first;
+        const double *y = ys + first;
+        std::fill(best, best + m, std::numeric_limits<double>::infinity());
+        std::fill(inside, inside + m, 0);
+
+        for (size_t e = 0; e < n; ++e) {
+            const double ax = polygon[e].x();
+            const double ay = polygon[e].y();
+            const double ex = polygon[(e + 1) % n].x() - ax;
+            const double ey = polygon[(e + 1) % n].y() - ay;
+            const double lengthSquared = ex * ex + ey * ey;
+            const double inverse = lengthSquared > 0.0 ? 1.0 / lengthSquared : 0.0;
+
+            for (size_t i = 0; i < m; ++i) {
+                double px = x[i] - ax;
+                double py = y[i] - ay;
+                double t = std::min(1.0, std::max(0.0, (px * ex + py * ey) * inverse));
+                double dx = px - t * ex;
+                double dy = py - t * ey;
+                best[i] = std::min(best[i], dx * dx + dy * dy);
+
+                // Луч вправо от точки пересекает ребро
+                bool straddles = (ay <= y[i]) != (ay + ey <= y[i]);
+                bool crosses = (ex * py - ey * px) * ey > 0.0;
+                inside[i] ^= static_cast<unsigned char>(straddles & crosses);
+            }
+        }
+
+        for (size_t i = 0; i < m; ++i) {
+            double distance = std::sqrt(best[i]);
+            out[first + i] = inside[i] ? -distance : distance;
+        }
+    }
+}
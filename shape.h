@@ -2,7 +2,9 @@
 #define SHAPE_H
 
 #include <QPointF>
+#include <QRectF>
 #include <QPainter>
+#include <memory>
 #include <vector>
 #include <cmath>
 #include <stdexcept>
@@ -32,6 +34,26 @@ public:
 
     virtual void draw(QPainter &painter) const = 0;
 
+    virtual QRectF boundingRect() const = 0;
+
+    // Контур фигуры ломаной; окружность аппроксимируется многоугольником
+    virtual std::vector<QPointF> outline() const = 0;
+
+    virtual std::unique_ptr<Shape> clone() const = 0;
+
+    // Заполняет ленивые кэши (площадь, периметр). После этого
+    // константные методы ничего не изменяют, и фигуру можно читать
+    // из нескольких потоков одновременно. Вершины и отложенные
+    // преобразования не трогаются, общий буфер вершин остаётся общим.
+    virtual void materialize() const {}
+
+    // Знаковое расстояние от точки до границы: < 0 внутри, > 0 снаружи
+    double signedDistance(const QPointF &point) const;
+
+    // То же для count точек (xs[i], ys[i]) в out[i]. По умолчанию —
+    // перебор рёбер outline(); фигуры простой формы считают точно.
+    virtual void signedDistances(const double *xs, const double *ys, double *out, size_t count) const;
+
 
     virtual QPointF centerOfMass() const {
         return QPointF(centerX, centerY);
@@ -59,4 +81,19 @@ QPointF scalePoint(const QPointF &point, double factor, double originX, double o
 
 double distanceBetweenPoints(const QPointF &p1, const QPointF &p2);
 
+QRectF boundingRectOf(const std::vector<QPointF> &points);
+
+// Выпуклая оболочка с положительной ориентированной площадью,
+// без точек на сторонах
+std::vector<QPointF> convexHullOf(std::vector<QPointF> points);
+
+// Общая отрисовка многоугольников: залитый контур, центр масс с
+// перекрестием и маркеры вершин
+void drawPolygonShape(QPainter &painter, const QPolygonF &polygon, const QPointF &center);
+
+// Знаковое расстояние до многоугольника перебором рёбер;
+// внутренность — по правилу чётности пересечений
+void signedDistancesToPolygon(const std::vector<QPointF> &polygon,
+                              const double *xs, const double *ys, double *out, size_t count);
+
 #endif // SHAPE_H
@@ -0,0 +1,207 @@
+#include "shapebatch.h"
+#include "parallel.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+static const size_t kValidationChunk = 4096;
+
+const char *rowErrorMessage(ShapeRowError error) {
+    switch (error) {
+    case RowValid: return "нет ошибки";
+    case UnknownType: return "неизвестный тип фигуры";
+    case NonFiniteValue: return "значение не является конечным числом";
+    case NonPositiveSize: return "размер должен быть положительным";
+    case InvalidParameter: return "параметр формы вне допустимого диапазона";
+    case InvalidCount: return "число концов или разрешение меньше 3";
+    case MissingColumn: return "для типа фигуры не задан нужный столбец";
+    }
+    return "неизвестная ошибка";
+}
+
+size_t ShapeBatch::validCount() const {
+    return circles.size() + parametric.size() + rectangles.size() + hearts.size();
+}
+
+std::vector<size_t> ShapeBatch::failedRows() const {
+    std::vector<size_t> rows;
+    for (size_t i = 0; i < errors.size(); ++i) {
+        if (errors[i] != RowValid) rows.push_back(i);
+    }
+    return rows;
+}
+
+Shape *ShapeBatch::shape(size_t row) {
+    return const_cast<Shape*>(static_cast<const ShapeBatch*>(this)->shape(row));
+}
+
+const Shape *ShapeBatch::shape(size_t row) const {
+    const Location &location = locations[row];
+    switch (location.storage) {
+    case CircleStorage: return &circles[location.index];
+    case ParametricStorage: return &parametric[location.index];
+    case RectangleStorage: return &rectangles[location.index];
+    case HeartStorage: return &hearts[location.index];
+    case NoStorage: break;
+    }
+    return nullptr;
+}
+
+static ShapeBatch::Storage storageOf(BulkShapeType type) {
+    switch (type) {
+    case BulkShapeType::Circle: return ShapeBatch::CircleStorage;
+    case BulkShapeType::Star:
+    case BulkShapeType::Hexagon:
+    case BulkShapeType::Square:
+    case BulkShapeType::Rhombus: return ShapeBatch::ParametricStorage;
+    case BulkShapeType::Rectangle: return ShapeBatch::RectangleStorage;
+    case BulkShapeType::Heart: return ShapeBatch::HeartStorage;
+    }
+    return ShapeBatch::NoStorage;
+}
+
+// Проверки строк [first, last). Общие для всех типов условия проверяются
+// по столбцам без ветвлений, затем — условия конкретного типа. Столбец
+// parameter проверяется только у типов, которые его читают: у остальных
+// там может лежать что угодно, в том числе NaN.
+static void validateRows(const ShapeColumns &columns, size_t first, size_t last,
+                         std::vector<ShapeRowError> &errors) {
+    const bool hasParameter = !columns.parameter.empty();
+    const bool hasCount = !columns.count.empty();
+    const bool hasAngle = !columns.angle.empty();
+
+    for (size_t i = first; i < last; ++i) {
+        const double angle = hasAngle ? columns.angle[i] : 0.0;
+        const bool finite = std::isfinite(columns.x[i]) & std::isfinite(columns.y[i]) &
+                            std::isfinite(columns.size[i]) & std::isfinite(angle);
+        const bool positive = columns.size[i] > 0.0;
+        errors[i] = !finite ? NonFiniteValue : (!positive ? NonPositiveSize : RowValid);
+    }
+
+    for (size_t i = first; i < last; ++i) {
+        if (errors[i] != RowValid) continue;
+
+        const double size = columns.size[i];
+        const double parameter = hasParameter ? columns.parameter[i] : 0.0;
+        const int count = hasCount ? columns.count[i] : 0;
+        switch (columns.type[i]) {
+        case BulkShapeType::Circle:
+        case BulkShapeType::Hexagon:
+        case BulkShapeType::Square:
+            break;
+        case BulkShapeType::Star:
+            if (!hasParameter || !hasCount) errors[i] = MissingColumn;
+            else if (!std::isfinite(parameter)) errors[i] = NonFiniteValue;
+            else if (count < 3) errors[i] = InvalidCount;
+            else if (!(parameter > 0.0 && parameter < size)) errors[i] = InvalidParameter;
+            break;
+        case BulkShapeType::Rhombus:
+            if (!hasParameter) errors[i] = MissingColumn;
+            else if (!std::isfinite(parameter)) errors[i] = NonFiniteValue;
+            else if (!(parameter > 0.0 && parameter < 90.0)) errors[i] = InvalidParameter;
+            break;
+        case BulkShapeType::Rectangle:
+            if (!hasParameter) errors[i] = MissingColumn;
+            else if (!std::isfinite(parameter)) errors[i] = NonFiniteValue;
+            else if (!(parameter > 0.0)) errors[i] = NonPositiveSize;
+            break;
+        case BulkShapeType::Heart:
+            if (!hasCount) errors[i] = MissingColumn;
+            else if (count < 3) errors[i] = InvalidCount;
+            break;
+        default:
+            errors[i] = UnknownType;
+            break;
+        }
+    }
+}
+
+static void checkColumnSize(size_t size, size_t rows, const char *name, bool optional) {
+    if (size == rows || (optional && size == 0)) return;
+    throw std::invalid_argument(
+        std::string("Длина столбца ") + name + " не совпадает с числом строк. Передано: " +
+        std::to_string(size) + ", строк: " + std::to_string(rows)
+        );
+}
+
+ShapeBatch buildShapes(const ShapeColumns &columns) {
+    const size_t rows = columns.type.size();
+    checkColumnSize(columns.x.size(), rows, "x", false);
+    checkColumnSize(columns.y.size(), rows, "y", false);
+    checkColumnSize(columns.size.size(), rows, "size", false);
+    checkColumnSize(columns.parameter.size(), rows, "parameter", true);
+    checkColumnSize(columns.count.size(), rows, "count", true);
+    checkColumnSize(columns.angle.size(), rows, "angle", true);
+
+    ShapeBatch batch;
+    batch.errors.resize(rows);
+    batch.locations.resize(rows);
+
+    parallelFor((rows + kValidationChunk - 1) / kValidationChunk, [&](size_t chunk) {
+        const size_t first = chunk * kValidationChunk;
+        validateRows(columns, first, std::min(rows, first + kValidationChunk), batch.errors);
+    });
+
+    // Строки каждого хранилища по порядку; хранилища заполняются параллельно
+    std::vector<std::vector<size_t>> rowsByStorage(5);
+    for (size_t i = 0; i < rows; ++i) {
+        if (batch.errors[i] == RowValid) rowsByStorage[storageOf(columns.type[i])].push_back(i);
+    }
+
+    batch.circles.reserve(rowsByStorage[ShapeBatch::CircleStorage].size());
+    batch.parametric.reserve(rowsByStorage[ShapeBatch::ParametricStorage].size());
+    batch.rectangles.reserve(rowsByStorage[ShapeBatch::RectangleStorage].size());
+    batch.hearts.reserve(rowsByStorage[ShapeBatch::HeartStorage].size());
+
+    auto angleAt = [&](size_t row) { return columns.angle.empty() ? 0.0 : columns.angle[row]; };
+
+    parallelFor(rowsByStorage.size(), [&](size_t storage) {
+        for (size_t row : rowsByStorage[storage]) {
+            const double x = columns.x[row];
+            const double y = columns.y[row];
+            const double size = columns.size[row];
+            const double angle = angleAt(row);
+            uint32_t index = 0;
+
+            switch (storage) {
+            case ShapeBatch::CircleStorage:
+                index = static_cast<uint32_t>(batch.circles.size());
+                batch.circles.emplace_back(x, y, size);
+                break;
+            case ShapeBatch::ParametricStorage:
+                index = static_cast<uint32_t>(batch.parametric.size());
+                switch (columns.type[row]) {
+                case BulkShapeType::Star:
+                    batch.parametric.push_back(ParametricShape::star(x, y, columns.count[row], size,
+                                                                     columns.parameter[row], angle));
+                    break;
+                case BulkShapeType::Hexagon:
+                    batch.parametric.push_back(ParametricShape::hexagon(x, y, size, angle));
+                    break;
+                case BulkShapeType::Square:
+                    batch.parametric.push_back(ParametricShape::square(x, y, size, angle));
+                    break;
+                default:
+                    batch.parametric.push_back(ParametricShape::rhombus(x, y, size, columns.parameter[row], angle));
+                    break;
+                }
+                break;
+            case ShapeBatch::RectangleStorage:
+                index = static_cast<uint32_t>(batch.rectangles.size());
+                batch.rectangles.emplace_back(x, y, size, columns.parameter[row]);
+                if (angle != 0.0) batch.rectangles.back().rotate(angle, x, y);
+                break;
+            case ShapeBatch::HeartStorage:
+                index = static_cast<uint32_t>(batch.hearts.size());
+                batch.hearts.emplace_back(x, y, size, columns.count[row]);
+                if (angle != 0.0) batch.hearts.back().rotate(angle, x, y);
+                break;
+            }
+
+            batch.locations[row] = {static_cast<ShapeBatch::Storage>(storage), index};
+        }
+    });
+
+    return batch;
+}
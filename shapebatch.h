@@ -0,0 +1,95 @@
+#ifndef SHAPEBATCH_H
+#define SHAPEBATCH_H
+
+#include "circle.h"
+#include "heart.h"
+#include "parametricshape.h"
+#include "rectangle.h"
+#include <cstdint>
+#include <vector>
+
+enum class BulkShapeType : unsigned char {
+    Circle,
+    Star,
+    Hexagon,
+    Square,
+    Rhombus,
+    Rectangle,
+    Heart
+};
+
+// Параметры фигур по столбцам, строка — одна фигура. Смысл size,
+// parameter и count зависит от типа:
+//   Circle    — size: радиус
+//   Star      — size: внешний радиус, parameter: внутренний, count: концы
+//   Hexagon, Square — size: сторона
+//   Rhombus   — size: сторона, parameter: острый угол в градусах
+//   Rectangle — size: ширина, parameter: высота
+//   Heart     — size: размер, count: разрешение
+// Неиспользуемые столбцы для строки не проверяются; parameter, count
+// и angle можно оставить пустыми, если ни одной строке они не нужны
+// (angle — без поворотов).
+struct ShapeColumns {
+    std::vector<BulkShapeType> type;
+    std::vector<double> x;
+    std::vector<double> y;
+    std::vector<double> size;
+    std::vector<double> parameter;
+    std::vector<int> count;
+    std::vector<double> angle;
+};
+
+enum ShapeRowError : unsigned char {
+    RowValid = 0,
+    UnknownType,
+    NonFiniteValue,
+    NonPositiveSize,
+    InvalidParameter,
+    InvalidCount,
+    MissingColumn
+};
+
+const char *rowErrorMessage(ShapeRowError error);
+
+// Фигуры одного вызова buildShapes, сложенные подряд по типам: звёзды,
+// шестиугольники, квадраты и ромбы — параметрически, без массивов вершин.
+class ShapeBatch {
+public:
+    enum Storage : unsigned char {
+        NoStorage,
+        CircleStorage,
+        ParametricStorage,
+        RectangleStorage,
+        HeartStorage
+    };
+
+    struct Location {
+        Storage storage = NoStorage;
+        uint32_t index = 0;
+    };
+
+    std::vector<Circle> circles;
+    std::vector<ParametricShape> parametric;
+    std::vector<Rectangle> rectangles;
+    std::vector<Heart> hearts;
+
+    // По строкам входа
+    std::vector<ShapeRowError> errors;
+    std::vector<Location> locations;
+
+    size_t rowCount() const { return errors.size(); }
+    size_t validCount() const;
+    std::vector<size_t> failedRows() const;
+
+    // nullptr для строк с ошибкой
+    Shape *shape(size_t row);
+    const Shape *shape(size_t row) const;
+};
+
+// Сначала все строки проверяются одним параллельным проходом (код ошибки
+// на строку, без исключений), затем корректные строки строятся в
+// хранилища нужного типа, заранее зарезервированные по числу строк.
+// Исключение бросается только при разной длине обязательных столбцов.
+ShapeBatch buildShapes(const ShapeColumns &columns);
+
+#endif // SHAPEBATCH_H
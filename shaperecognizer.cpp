@@ -0,0 +1,174 @@
+#include "shaperecognizer.h"
+#include "triangle.h"
+#include "quadrilateral.h"
+#include "rectangle.h"
+#include "square.h"
+#include "rhombus.h"
+#include "hexagon.h"
+#include "star.h"
+#include <cmath>
+
+static double directionDeg(const QPointF &v) {
+    return std::atan2(v.y(), v.x()) * 180.0 / M_PI;
+}
+
+static double lengthSquared(const QPointF &v) {
+    return v.x() * v.x() + v.y() * v.y();
+}
+
+static std::unique_ptr<Polygon> recognizeQuadrilateral(const std::vector<QPointF> &local,
+                                                       const QPointF &center, double radius,
+                                                       const std::vector<QPointF> &verts,
+                                                       double tolerance)
+{
+    unsigned char flags = Quadrilateral::classify(local[0], local[1], local[2], local[3], tolerance);
+
+    const double cx = center.x();
+    const double cy = center.y();
+    QPointF e0 = local[1] - local[0];
+    QPointF e1 = local[2] - local[1];
+
+    if (flags & Quadrilateral::SquareKind) {
+        double side = std::sqrt(0.5 * (lengthSquared(e0) + lengthSquared(e1))) * radius;
+        auto square = std::make_unique<Square>(cx, cy, side);
+        square->rotate(directionDeg(e0), cx, cy);
+        return square;
+    }
+
+    if (flags & Quadrilateral::RectangleKind) {
+        double width = std::sqrt(lengthSquared(e0)) * radius;
+        double height = std::sqrt(lengthSquared(e1)) * radius;
+        auto rectangle = std::make_unique<Rectangle>(cx, cy, width, height);
+        rectangle->rotate(directionDeg(e0), cx, cy);
+        return rectangle;
+    }
+
+    if (flags & Quadrilateral::RhombusKind) {
+        QPointF d02 = local[2] - local[0];
+        QPointF d13 = local[3] - local[1];
+        double l02 = std::sqrt(lengthSquared(d02));
+        double l13 = std::sqrt(lengthSquared(d13));
+
+        const QPointF &longDiagonal = (l02 >= l13) ? d02 : d13;
+        double longLength = std::max(l02, l13);
+        double shortLength = std::min(l02, l13);
+
+        double acute = 2.0 * std::atan2(shortLength, longLength) * 180.0 / M_PI;
+        if (acute > 0.0 && acute < 90.0) {
+            double side = 0.5 * std::sqrt(l02 * l02 + l13 * l13) * radius;
+            auto rhombus = std::make_unique<Rhombus>(cx, cy, side, acute);
+            rhombus->rotate(directionDeg(longDiagonal), cx, cy);
+            return rhombus;
+        }
+    }
+
+    return std::make_unique<Quadrilateral>(verts[0], verts[1], verts[2], verts[3]);
+}
+
+static bool isRegularHexagon(const std::vector<QPointF> &local, double tolerance) {
+    for (size_t i = 0; i < 6; ++i) {
+        const QPointF &v = local[i];
+        const QPointF &next = local[(i + 1) % 6];
+        if (std::abs(lengthSquared(v) - 1.0) > 2.0 * tolerance) return false;
+        if (std::abs(lengthSquared(next - v) - 1.0) > 2.0 * tolerance) return false;
+    }
+    return true;
+}
+
+static std::unique_ptr<Polygon> recognizeStar(const std::vector<QPointF> &local,
+                                              const QPointF &center, double radius,
+                                              double tolerance)
+{
+    const size_t n = local.size();
+    const int points = static_cast<int>(n / 2);
+
+    double r0 = std::sqrt(lengthSquared(local[0]));
+    double r1 = std::sqrt(lengthSquared(local[1]));
+    if (std::abs(r0 - r1) <= tolerance) return nullptr;
+
+    const double step = M_PI / points;
+    const double cosStep = std::cos(step);
+    const double sinStep = std::sin(step);
+    int orientation = 0;
+
+    for (size_t i = 0; i < n; ++i) {
+        const QPointF &v = local[i];
+        const QPointF &next = local[(i + 1) % n];
+
+        double expected = (i % 2 == 0) ? r0 : r1;
+        if (std::abs(std::sqrt(lengthSquared(v)) - expected) > tolerance) return nullptr;
+
+        double rr = r0 * r1;
+        double dot = v.x() * next.x() + v.y() * next.y();
+        double cross = v.x() * next.y() - v.y() * next.x();
+        if (std::abs(dot - rr * cosStep) > tolerance) return nullptr;
+        if (std::abs(std::abs(cross) - rr * sinStep) > tolerance) return nullptr;
+
+        int sign = (cross > 0.0) ? 1 : -1;
+        if (orientation == 0) orientation = sign;
+        else if (orientation != sign) return nullptr;
+    }
+
+    const QPointF &tip = (r0 > r1) ? local[0] : local[1];
+    double outer = std::max(r0, r1) * radius;
+    double inner = std::min(r0, r1) * radius;
+
+    auto star = std::make_unique<Star>(center.x(), center.y(), points, outer, inner);
+    star->rotate(directionDeg(tip) + 90.0, center.x(), center.y());
+    return star;
+}
+
+std::unique_ptr<Polygon> recognizePolygon(const Polygon &polygon, double tolerance) {
+    const std::vector<QPointF> verts = polygon.getVertices();
+    const size_t n = verts.size();
+    const QPointF center = polygon.centerOfMass();
+
+    if (n == 3) {
+        return std::make_unique<Triangle>(verts[0], verts[1], verts[2]);
+    }
+
+    double radius = 0.0;
+    for (const QPointF &v : verts) {
+        radius = std::max(radius, lengthSquared(v - center));
+    }
+    radius = std::sqrt(radius);
+
+    if (radius > 1e-12) {
+        std::vector<QPointF> local;
+        local.reserve(n);
+        for (const QPointF &v : verts) {
+            local.push_back((v - center) * (1.0 / radius));
+        }
+
+        if (n == 4) {
+            return recognizeQuadrilateral(local, center, radius, verts, tolerance);
+        }
+
+        if (n == 6 && isRegularHexagon(local, tolerance)) {
+            auto hexagon = std::make_unique<Hexagon>(center.x(), center.y(), radius, true);
+            hexagon->rotate(directionDeg(local[0]), center.x(), center.y());
+            return hexagon;
+        }
+
+        if (n >= 6 && n % 2 == 0) {
+            if (auto star = recognizeStar(local, center, radius, tolerance)) {
+                return star;
+            }
+        }
+    }
+
+    return std::make_unique<Polygon>(verts);
+}
+
+std::vector<std::unique_ptr<Polygon>> recognizePolygons(const std::vector<Polygon> &polygons,
+                                                        double tolerance)
+{
+    std::vector<std::unique_ptr<Polygon>> result;
+    result.reserve(polygons.size());
+
+    for (const Polygon &polygon : polygons) {
+        result.push_back(recognizePolygon(polygon, tolerance));
+    }
+
+    return result;
+}
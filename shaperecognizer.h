@@ -0,0 +1,18 @@
+#ifndef SHAPERECOGNIZER_H
+#define SHAPERECOGNIZER_H
+
+#include "polygon.h"
+#include <memory>
+#include <vector>
+
+// Восстанавливает по вершинам наиболее конкретный подкласс:
+// Triangle, Square, Rectangle, Rhombus, Quadrilateral, правильный Hexagon, Star.
+// Если ничего не подошло — возвращает копию в виде Polygon.
+// tolerance задаётся относительно радиуса фигуры (макс. расстояния от центра масс).
+// Сохраняется множество вершин, но не обязательно их порядок.
+std::unique_ptr<Polygon> recognizePolygon(const Polygon &polygon, double tolerance = 1e-6);
+
+std::vector<std::unique_ptr<Polygon>> recognizePolygons(const std::vector<Polygon> &polygons,
+                                                        double tolerance = 1e-6);
+
+#endif // SHAPERECOGNIZER_H
@@ -0,0 +1,53 @@
+#ifndef SHAREDVERTICES_H
+#define SHAREDVERTICES_H
+
+#include <QPointF>
+#include <memory>
+#include <vector>
+
+// Буфер вершин, общий для копий фигуры (копирование при записи).
+// Копия фигуры разделяет тот же буфер; собственный буфер появляется
+// только при первом изменении вершин через detach().
+class SharedVertices {
+private:
+    std::shared_ptr<std::vector<QPointF>> data;
+
+public:
+    SharedVertices() : data(std::make_shared<std::vector<QPointF>>()) {}
+
+    SharedVertices(std::vector<QPointF> points)
+        : data(std::make_shared<std::vector<QPointF>>(std::move(points))) {}
+
+    SharedVertices &operator=(std::vector<QPointF> points) {
+        data = std::make_shared<std::vector<QPointF>>(std::move(points));
+        return *this;
+    }
+
+    const std::vector<QPointF> &get() const { return *data; }
+
+    size_t size() const { return data->size(); }
+    bool empty() const { return data->empty(); }
+    const QPointF &operator[](size_t index) const { return (*data)[index]; }
+    std::vector<QPointF>::const_iterator begin() const { return data->begin(); }
+    std::vector<QPointF>::const_iterator end() const { return data->end(); }
+
+    bool isShared() const { return data.use_count() > 1; }
+
+    // Вектор для изменения; если буфер общий, сначала копируется
+    std::vector<QPointF> &detach() {
+        if (isShared()) {
+            data = std::make_shared<std::vector<QPointF>>(*data);
+        }
+        return *data;
+    }
+
+    void assign(const QPointF *first, const QPointF *last) {
+        if (isShared()) {
+            data = std::make_shared<std::vector<QPointF>>(first, last);
+        } else {
+            data->assign(first, last);
+        }
+    }
+};
+
+#endif // SHAREDVERTICES_H
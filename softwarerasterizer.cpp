@@ -0,0 +1,252 @@
+#include "softwarerasterizer.h"
+#include "circle.h"
+#include "heart.h"
+#include "parallel.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+static const int kSubsamples = 4;
+
+static inline uint32_t scaleColor(uint32_t color, uint32_t factor) {
+    // factor в [0, 255]; два канала за одно умножение
+    uint32_t rb = (color & 0x00ff00ffu) * factor;
+    uint32_t ag = ((color >> 8) & 0x00ff00ffu) * factor;
+    rb = ((rb + ((rb >> 8) & 0x00ff00ffu) + 0x00800080u) >> 8) & 0x00ff00ffu;
+    ag = (ag + ((ag >> 8) & 0x00ff00ffu) + 0x00800080u) & 0xff00ff00u;
+    return rb | ag;
+}
+
+static inline uint32_t blendOver(uint32_t dst, uint32_t src, uint32_t coverage) {
+    uint32_t s = scaleColor(src, coverage);
+    return s + scaleColor(dst, 255u - (s >> 24));
+}
+
+SoftwareRasterizer::SoftwareRasterizer(int width, int height)
+    : imageWidth(width), imageHeight(height), tileSize(64), threadCount(0),
+    background(0), offsetX(0.0), offsetY(0.0)
+{
+    if (width <= 0 || height <= 0) {
+        throw std::invalid_argument(
+            "Размеры изображения должны быть положительными. Ширина: " +
+            std::to_string(width) + ", высота: " + std::to_string(height)
+            );
+    }
+
+    buffer.assign(static_cast<size_t>(width) * static_cast<size_t>(height), 0u);
+}
+
+void SoftwareRasterizer::setTileSize(int size) {
+    if (size < 8) {
+        throw std::invalid_argument("Размер плитки должен быть >= 8. Передано: " + std::to_string(size));
+    }
+    tileSize = size;
+}
+
+uint32_t SoftwareRasterizer::premultiply(const QColor &color) {
+    uint32_t a = static_cast<uint32_t>(color.alpha());
+    uint32_t r = static_cast<uint32_t>(color.red()) * a / 255u;
+    uint32_t g = static_cast<uint32_t>(color.green()) * a / 255u;
+    uint32_t b = static_cast<uint32_t>(color.blue()) * a / 255u;
+    return (a << 24) | (r << 16) | (g << 8) | b;
+}
+
+QColor SoftwareRasterizer::defaultFillColor(const Shape &shape) {
+    if (dynamic_cast<const Heart*>(&shape)) return QColor(255, 105, 180, 200);
+    if (dynamic_cast<const Circle*>(&shape)) return QColor(0, 0, 255, 100);
+    return QColor(144, 238, 144, 100);
+}
+
+SoftwareRasterizer::PreparedShape SoftwareRasterizer::prepare(const Shape &shape) const {
+    PreparedShape prepared;
+    prepared.color = premultiply(defaultFillColor(shape));
+    prepared.isCircle = false;
+    prepared.cx = prepared.cy = prepared.radius = 0.0;
+
+    if (const Circle *circle = dynamic_cast<const Circle*>(&shape)) {
+        prepared.isCircle = true;
+        prepared.cx = circle->getCenterX() + offsetX;
+        prepared.cy = circle->getCenterY() + offsetY;
+        prepared.radius = circle->getRadius();
+        prepared.bounds = QRectF(prepared.cx - prepared.radius - 1.0, prepared.cy - prepared.radius - 1.0,
+                                 2.0 * prepared.radius + 2.0, 2.0 * prepared.radius + 2.0);
+        return prepared;
+    }
+
+    std::vector<QPointF> points = shape.outline();
+    const size_t n = points.size();
+    prepared.edges.reserve(n);
+
+    for (size_t i = 0; i < n; ++i) {
+        QPointF a = points[i];
+        QPointF b = points[(i + 1) % n];
+        if (a.y() == b.y()) continue;
+        if (a.y() > b.y()) std::swap(a, b);
+
+        Edge edge;
+        edge.x0 = a.x() + offsetX;
+        edge.y0 = a.y() + offsetY;
+        edge.x1 = b.x() + offsetX;
+        edge.y1 = b.y() + offsetY;
+        edge.slope = (edge.x1 - edge.x0) / (edge.y1 - edge.y0);
+        prepared.edges.push_back(edge);
+    }
+
+    prepared.bounds = boundingRectOf(points).translated(offsetX, offsetY);
+    return prepared;
+}
+
+void SoftwareRasterizer::fillPolygon(const PreparedShape &shape, int x0, int y0, int x1, int y1,
+                                     std::vector<const Edge*> &edges, std::vector<double> &crossings,
+                                     std::vector<float> &coverage)
+{
+    edges.clear();
+    for (const Edge &edge : shape.edges) {
+        // Рёбра целиком правее плитки не влияют на чётность внутри неё
+        if (edge.y1 <= y0 || edge.y0 >= y1) continue;
+        if (std::min(edge.x0, edge.x1) >= x1) continue;
+        edges.push_back(&edge);
+    }
+    if (edges.empty()) return;
+
+    // Обрабатываем только пересечение плитки с границами фигуры
+    y0 = std::max(y0, static_cast<int>(std::floor(shape.bounds.top())));
+    y1 = std::min(y1, static_cast<int>(std::ceil(shape.bounds.bottom())));
+    int right = std::min(x1, static_cast<int>(std::ceil(shape.bounds.right())));
+    int left = std::max(x0, static_cast<int>(std::floor(shape.bounds.left())));
+    if (left >= right) return;
+
+    const float weight = 1.0f / kSubsamples;
+
+    for (int y = y0; y < y1; ++y) {
+        std::fill(coverage.begin() + (left - x0), coverage.begin() + (right - x0), 0.0f);
+        bool touched = false;
+
+        for (int s = 0; s < kSubsamples; ++s) {
+            double sy = y + (s + 0.5) / kSubsamples;
+
+            crossings.clear();
+            for (const Edge *edge : edges) {
+                if (sy < edge->y0 || sy >= edge->y1) continue;
+                crossings.push_back(edge->x0 + (sy - edge->y0) * edge->slope);
+            }
+            if (crossings.empty()) continue;
+            std::sort(crossings.begin(), crossings.end());
+
+            for (size_t k = 0; k < crossings.size(); k += 2) {
+                double a = std::max(crossings[k], static_cast<double>(left));
+                double b = (k + 1 < crossings.size()) ? crossings[k + 1] : static_cast<double>(right);
+                b = std::min(b, static_cast<double>(right));
+                if (a >= b) continue;
+
+                touched = true;
+                int ia = static_cast<int>(std::floor(a));
+                int ib = static_cast<int>(std::floor(b));
+
+                if (ia == ib) {
+                    coverage[ia - x0] += static_cast<float>(b - a) * weight;
+                    continue;
+                }
+
+                coverage[ia - x0] += static_cast<float>(ia + 1 - a) * weight;
+                for (int x = ia + 1; x < ib; ++x) {
+                    coverage[x - x0] += weight;
+                }
+                if (ib < right) {
+                    coverage[ib - x0] += static_cast<float>(b - ib) * weight;
+                }
+            }
+        }
+
+        if (!touched) continue;
+
+        uint32_t *row = buffer.data() + static_cast<size_t>(y) * imageWidth;
+        for (int x = left; x < right; ++x) {
+            float c = std::min(coverage[x - x0], 1.0f);
+            if (c <= 0.0f) continue;
+            uint32_t c8 = static_cast<uint32_t>(c * 255.0f + 0.5f);
+            row[x] = blendOver(row[x], shape.color, c8);
+        }
+    }
+}
+
+void SoftwareRasterizer::fillCircle(const PreparedShape &shape, int x0, int y0, int x1, int y1) {
+    const double r = shape.radius;
+
+    y0 = std::max(y0, static_cast<int>(std::floor(shape.bounds.top())));
+    y1 = std::min(y1, static_cast<int>(std::ceil(shape.bounds.bottom())));
+    x0 = std::max(x0, static_cast<int>(std::floor(shape.bounds.left())));
+    x1 = std::min(x1, static_cast<int>(std::ceil(shape.bounds.right())));
+
+    for (int y = y0; y < y1; ++y) {
+        double dy = y + 0.5 - shape.cy;
+        if (std::abs(dy) > r + 1.0) continue;
+
+        uint32_t *row = buffer.data() + static_cast<size_t>(y) * imageWidth;
+        for (int x = x0; x < x1; ++x) {
+            double dx = x + 0.5 - shape.cx;
+            double distance = std::sqrt(dx * dx + dy * dy);
+            double c = std::min(1.0, std::max(0.0, r + 0.5 - distance));
+            if (c <= 0.0) continue;
+
+            uint32_t c8 = static_cast<uint32_t>(c * 255.0 + 0.5);
+            row[x] = blendOver(row[x], shape.color, c8);
+        }
+    }
+}
+
+void SoftwareRasterizer::render(const std::vector<const Shape*> &shapes) {
+    std::fill(buffer.begin(), buffer.end(), background);
+
+    std::vector<PreparedShape> prepared(shapes.size());
+    parallelFor(shapes.size(), [&](size_t i) {
+        prepared[i] = prepare(*shapes[i]);
+    }, threadCount);
+
+    const int tilesX = (imageWidth + tileSize - 1) / tileSize;
+    const int tilesY = (imageHeight + tileSize - 1) / tileSize;
+    std::vector<std::vector<uint32_t>> bins(static_cast<size_t>(tilesX) * tilesY);
+
+    for (size_t i = 0; i < prepared.size(); ++i) {
+        const QRectF &b = prepared[i].bounds;
+        int tx0 = std::max(0, static_cast<int>(std::floor(b.left())) / tileSize);
+        int ty0 = std::max(0, static_cast<int>(std::floor(b.top())) / tileSize);
+        int tx1 = std::min(tilesX - 1, static_cast<int>(std::floor(b.right())) / tileSize);
+        int ty1 = std::min(tilesY - 1, static_cast<int>(std::floor(b.bottom())) / tileSize);
+        if (b.right() < 0.0 || b.bottom() < 0.0) continue;
+
+        for (int ty = ty0; ty <= ty1; ++ty) {
+            for (int tx = tx0; tx <= tx1; ++tx) {
+                bins[static_cast<size_t>(ty) * tilesX + tx].push_back(static_cast<uint32_t>(i));
+            }
+        }
+    }
+
+    parallelFor(bins.size(), [&](size_t tile) {
+        if (bins[tile].empty()) return;
+
+        int x0 = static_cast<int>(tile % tilesX) * tileSize;
+        int y0 = static_cast<int>(tile / tilesX) * tileSize;
+        int x1 = std::min(x0 + tileSize, imageWidth);
+        int y1 = std::min(y0 + tileSize, imageHeight);
+
+        std::vector<const Edge*> edges;
+        std::vector<double> crossings;
+        std::vector<float> coverage(static_cast<size_t>(tileSize));
+
+        for (uint32_t index : bins[tile]) {
+            const PreparedShape &shape = prepared[index];
+            if (shape.isCircle) {
+                fillCircle(shape, x0, y0, x1, y1);
+            } else {
+                fillPolygon(shape, x0, y0, x1, y1, edges, crossings, coverage);
+            }
+        }
+    }, threadCount);
+}
+
+QImage SoftwareRasterizer::toImage() const {
+    return QImage(reinterpret_cast<const uchar*>(buffer.data()), imageWidth, imageHeight,
+                  imageWidth * static_cast<int>(sizeof(uint32_t)),
+                  QImage::Format_ARGB32_Premultiplied).copy();
+}
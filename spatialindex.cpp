@@ -0,0 +1,125 @@
+#include "spatialindex.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+static bool overlaps(const QRectF &a, const QRectF &b) {
+    return a.left() <= b.right() && b.left() <= a.right() &&
+           a.top() <= b.bottom() && b.top() <= a.bottom();
+}
+
+SpatialIndex::SpatialIndex(double cell)
+    : cellSize(cell)
+{
+    if (cellSize <= 0.0) {
+        throw std::invalid_argument(
+            "Размер ячейки должен быть положительным. Передано: " + std::to_string(cellSize)
+            );
+    }
+}
+
+uint64_t SpatialIndex::cellKey(int cx, int cy) {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(cx)) << 32) | static_cast<uint32_t>(cy);
+}
+
+void SpatialIndex::cellRange(const QRectF &rect, int &x0, int &y0, int &x1, int &y1) const {
+    x0 = static_cast<int>(std::floor(rect.left() / cellSize));
+    y0 = static_cast<int>(std::floor(rect.top() / cellSize));
+    x1 = static_cast<int>(std::floor(rect.right() / cellSize));
+    y1 = static_cast<int>(std::floor(rect.bottom() / cellSize));
+}
+
+void SpatialIndex::insert(size_t id, const QRectF &bounds) {
+    if (contains(id)) {
+        update(id, bounds);
+        return;
+    }
+
+    if (id >= present.size()) {
+        present.resize(id + 1, false);
+        boundsById.resize(id + 1);
+    }
+    present[id] = true;
+    boundsById[id] = bounds;
+
+    int x0, y0, x1, y1;
+    cellRange(bounds, x0, y0, x1, y1);
+    for (int cy = y0; cy <= y1; ++cy) {
+        for (int cx = x0; cx <= x1; ++cx) {
+            cells[cellKey(cx, cy)].push_back(id);
+        }
+    }
+}
+
+void SpatialIndex::remove(size_t id) {
+    if (!contains(id)) return;
+
+    int x0, y0, x1, y1;
+    cellRange(boundsById[id], x0, y0, x1, y1);
+    for (int cy = y0; cy <= y1; ++cy) {
+        for (int cx = x0; cx <= x1; ++cx) {
+            auto it = cells.find(cellKey(cx, cy));
+            if (it == cells.end()) continue;
+
+            std::vector<size_t> &ids = it->second;
+            ids.erase(std::remove(ids.begin(), ids.end(), id), ids.end());
+            if (ids.empty()) cells.erase(it);
+        }
+    }
+
+    present[id] = false;
+}
+
+void SpatialIndex::update(size_t id, const QRectF &bounds) {
+    if (contains(id)) {
+        int ox0, oy0, ox1, oy1;
+        int nx0, ny0, nx1, ny1;
+        cellRange(boundsById[id], ox0, oy0, ox1, oy1);
+        cellRange(bounds, nx0, ny0, nx1, ny1);
+
+        // Типичный случай — небольшое перемещение внутри тех же ячеек
+        if (ox0 == nx0 && oy0 == ny0 && ox1 == nx1 && oy1 == ny1) {
+            boundsById[id] = bounds;
+            return;
+        }
+        remove(id);
+    }
+    insert(id, bounds);
+}
+
+void SpatialIndex::clear() {
+    cells.clear();
+    boundsById.clear();
+    present.clear();
+}
+
+std::vector<size_t> SpatialIndex::query(const QRectF &area) const {
+    return query(std::vector<QRectF>{area});
+}
+
+std::vector<size_t> SpatialIndex::query(const std::vector<QRectF> &areas) const {
+    std::vector<size_t> result;
+
+    for (const QRectF &area : areas) {
+        int x0, y0, x1, y1;
+        cellRange(area, x0, y0, x1, y1);
+
+        for (int cy = y0; cy <= y1; ++cy) {
+            for (int cx = x0; cx <= x1; ++cx) {
+                auto it = cells.find(cellKey(cx, cy));
+                if (it == cells.end()) continue;
+
+                for (size_t id : it->second) {
+                    if (overlaps(boundsById[id], area)) {
+                        result.push_back(id);
+                    }
+                }
+            }
+        }
+    }
+
+    std::sort(result.begin(), result.end());
+    result.erase(std::unique(result.begin(), result.end()), result.end());
+    return result;
+}
@@ -0,0 +1,37 @@
+#ifndef SPATIALINDEX_H
+#define SPATIALINDEX_H
+
+#include <QRectF>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+// Равномерная сетка ячеек для поиска объектов по ограничивающим
+// прямоугольникам. Идентификаторы — индексы объектов в сцене.
+class SpatialIndex {
+private:
+    double cellSize;
+    std::unordered_map<uint64_t, std::vector<size_t>> cells;
+    std::vector<QRectF> boundsById;
+    std::vector<bool> present;
+
+    static uint64_t cellKey(int cx, int cy);
+    void cellRange(const QRectF &rect, int &x0, int &y0, int &x1, int &y1) const;
+
+public:
+    explicit SpatialIndex(double cell = 128.0);
+
+    void insert(size_t id, const QRectF &bounds);
+    void update(size_t id, const QRectF &bounds);
+    void remove(size_t id);
+    void clear();
+
+    bool contains(size_t id) const { return id < present.size() && present[id]; }
+    const QRectF &bounds(size_t id) const { return boundsById[id]; }
+
+    // Идентификаторы по возрастанию (порядок отрисовки)
+    std::vector<size_t> query(const QRectF &area) const;
+    std::vector<size_t> query(const std::vector<QRectF> &areas) const;
+};
+
+#endif // SPATIALINDEX_H
@@ -1,4 +1,5 @@
 #include "square.h"
+#include "instrumentation.h"
 #include <cmath>
 #include <stdexcept>
 #include <QDebug>
@@ -71,12 +72,15 @@ Square::Square(const QPointF &topLeft, const QPointF &bottomRight)
     side = width;
 }
 
-void Square::updateSide() {
-    double s0 = Quadrilateral::getSideLength(0);
-    double s1 = Quadrilateral::getSideLength(1);
-    double s2 = Quadrilateral::getSideLength(2);
-    double s3 = Quadrilateral::getSideLength(3);
-    side = (s0 + s1 + s2 + s3) / 4.0;
+void Square::rebuildVertices() {
+    const double h = side / 2.0;
+    const QPointF local[4] = {
+        QPointF(-h, -h),
+        QPointF( h, -h),
+        QPointF( h,  h),
+        QPointF(-h,  h)
+    };
+    setLocalFrame(local, 4, orientation);
 }
 
 void Square::setSide(double s) {
@@ -92,15 +96,22 @@ void Square::setSide(double s) {
 }
 
 void Square::move(double dx, double dy) {
+    SHAPE_PROBE_SHAPE(Move);
     Quadrilateral::move(dx, dy);
 }
 
 void Square::rotate(double angleDeg, double originX, double originY) {
-    Quadrilateral::rotate(angleDeg, originX, originY);
-    updateSide();
+    SHAPE_PROBE_SHAPE(Rotate);
+    QPointF newCenter = rotatePoint(QPointF(centerX, centerY), angleDeg, originX, originY);
+    centerX = newCenter.x();
+    centerY = newCenter.y();
+
+    orientation = std::fmod(orientation + angleDeg, 360.0);
+    rebuildVertices();
 }
 
 void Square::scale(double factor, double originX, double originY) {
+    SHAPE_PROBE_SHAPE(Scale);
     if (factor <= 0.0) {
         throw std::invalid_argument(
             "Коэффициент масштабирования должен быть положительным. "
@@ -108,8 +119,12 @@ void Square::scale(double factor, double originX, double originY) {
             );
     }
 
-    Quadrilateral::scale(factor, originX, originY);
+    QPointF newCenter = scalePoint(QPointF(centerX, centerY), factor, originX, originY);
+    centerX = newCenter.x();
+    centerY = newCenter.y();
+
     side *= factor;
+    rebuildVertices();
 }
 
 bool Square::hasRightAngles(double tolerance) const {
@@ -120,3 +135,7 @@ bool Square::hasRightAngles(double tolerance) const {
     }
     return true;
 }
+
+void Square::signedDistances(const double *xs, const double *ys, double *out, size_t count) const {
+    boxSignedDistances(QPointF(centerX, centerY), orientation, side / 2.0, side / 2.0, xs, ys, out, count);
+}
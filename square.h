@@ -6,7 +6,12 @@
 class Square : public Quadrilateral {
 private:
     double side;
-    void updateSide();
+    double orientation = 0.0;
+
+    void rebuildVertices();
+
+protected:
+    bool verticesFollowParameters() const override { return true; }
 
 public:
 
@@ -14,13 +19,17 @@ public:
 
     Square(const QPointF &topLeft, const QPointF &bottomRight);
 
+    std::unique_ptr<Shape> clone() const override { return std::make_unique<Square>(*this); }
+
     double getSide() const { return side; }
+    double getOrientation() const { return orientation; }
 
     void setSide(double s);
 
     void move(double dx, double dy) override;
     void rotate(double angleDeg, double originX, double originY) override;
     void scale(double factor, double originX, double originY) override;
+    void signedDistances(const double *xs, const double *ys, double *out, size_t count) const override;
 
     double area() const override { return side * side; }
     double perimeter() const override { return 4.0 * side; }
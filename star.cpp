@@ -1,4 +1,5 @@
 #include "star.h"
+#include "instrumentation.h"
 #include <cmath>
 #include <stdexcept>
 #include <vector>
@@ -49,6 +50,7 @@ Star::Star(double x, double y, int p, double outerR, double innerR)
 }
 
 double Star::calculateGeometricArea() const {
+    SHAPE_PROBE_SHAPE(Area);
     if (vertexCount() < 3) return 0.0;
 
     double totalArea = 0.0;
@@ -73,6 +75,7 @@ double Star::calculateGeometricArea() const {
 }
 
 double Star::perimeter() const {
+    SHAPE_PROBE_SHAPE(Perimeter);
     if (vertexCount() < 3) return 0.0;
 
     double perimeter = 0.0;
@@ -17,6 +17,8 @@ protected:
 public:
     Star(double x, double y, int p, double outerR, double innerR);
 
+    std::unique_ptr<Shape> clone() const override { return std::make_unique<Star>(*this); }
+
     int getPointsCount() const { return points; }
     double getOuterRadius() const { return outerRadius; }
     double getInnerRadius() const { return innerRadius; }
@@ -32,6 +34,8 @@ public:
 class Star5 : public Star {
 public:
     Star5(double x, double y, double outerR, double innerR = 0.38196601125);
+
+    std::unique_ptr<Shape> clone() const override { return std::make_unique<Star5>(*this); }
 };
 
 class Star6 : public Star {
@@ -40,11 +44,15 @@ private:
 
 public:
     Star6(double x, double y, double outerR);
+
+    std::unique_ptr<Shape> clone() const override { return std::make_unique<Star6>(*this); }
 };
 
 class Star8 : public Star {
 public:
     Star8(double x, double y, double outerR, double innerR = 0.41421356237);
+
+    std::unique_ptr<Shape> clone() const override { return std::make_unique<Star8>(*this); }
 };
 
 #endif // STAR_H
@@ -0,0 +1,27 @@
+QT       += core gui testlib
+
+CONFIG += c++17 console testcase
+CONFIG -= app_bundle
+
+TEMPLATE = app
+TARGET = tst_geometry
+
+INCLUDEPATH += ..
+
+SOURCES += \
+    tst_geometry.cpp \
+    ../circle.cpp \
+    ../commandjournal.cpp \
+    ../geometrycore.cpp \
+    ../geometrylibrary.cpp \
+    ../heart.cpp \
+    ../hexagon.cpp \
+    ../instrumentation.cpp \
+    ../polygon.cpp \
+    ../quadrilateral.cpp \
+    ../rectangle.cpp \
+    ../rhombus.cpp \
+    ../scenestore.cpp \
+    ../shape.cpp \
+    ../square.cpp \
+    ../transform2d.cpp
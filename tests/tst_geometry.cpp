@@ -0,0 +1,100 @@
+#include "circle.h"
+#include "commandjournal.h"
+#include "geometrylibrary.h"
+#include "heart.h"
+#include "rectangle.h"
+#include "rhombus.h"
+#include "scenestore.h"
+#include <QtTest>
+
+class GeometryTest : public QObject {
+    Q_OBJECT
+
+private slots:
+    void libraryInstancesStayShared();
+    void libraryAreaMatchesShape();
+    void acuteAngleUndoKeepsRotation();
+    void parametricVerticesRejectEdits();
+};
+
+// Вершины формы остаются общими и после публикации экземпляров в сцене
+void GeometryTest::libraryInstancesStayShared() {
+    GeometryLibrary library;
+    const Heart heart(0.0, 0.0, 50.0, 60);
+
+    SceneStore scene;
+    for (int i = 0; i < 4; ++i) {
+        Heart copy(heart);
+        copy.rotate(17.0 * i, 3.0, 4.0);
+        copy.scale(1.0 + 0.5 * i, 0.0, 0.0);
+        copy.move(100.0 * i, 0.0);
+        scene.add(library.instantiate(library.add(copy)));
+    }
+
+    QCOMPARE(library.geometryCount(), size_t(1));
+    QVERIFY(library.geometry(0).vertices.isShared());
+
+    scene.edit(1, [](Shape &shape) { shape.rotate(10.0, 0.0, 0.0); });
+    QVERIFY(library.geometry(0).vertices.isShared());
+}
+
+// Площадь экземпляра — площадь исходной фигуры, а не её контура
+void GeometryTest::libraryAreaMatchesShape() {
+    GeometryLibrary library;
+    const Heart heart(10.0, 20.0, 40.0, 30);
+    const Circle circle(-5.0, 7.0, 12.0);
+
+    const ShapeInstance heartInstance = library.add(heart);
+    const ShapeInstance circleInstance = library.add(circle);
+
+    Heart bigger(heart);
+    bigger.scale(2.5, 0.0, 0.0);
+    const ShapeInstance biggerInstance = library.add(bigger);
+
+    QCOMPARE(biggerInstance.geometry, heartInstance.geometry);
+    QVERIFY(qAbs(library.area(heartInstance) - heart.area()) < 1e-9 * heart.area());
+    QVERIFY(qAbs(library.area(biggerInstance) - bigger.area()) < 1e-9 * bigger.area());
+    QVERIFY(qAbs(library.area(circleInstance) - circle.area()) < 1e-9 * circle.area());
+    QVERIFY(qAbs(library.perimeter(circleInstance) - circle.perimeter()) < 1e-9 * circle.perimeter());
+}
+
+// Отмена setAcuteAngle после поворота возвращает ромб в прежнее
+// повёрнутое положение, а не в выровненное по осям
+void GeometryTest::acuteAngleUndoKeepsRotation() {
+    Rhombus rhombus(100.0, 50.0, 40.0, 60.0);
+    CommandJournal journal;
+    journal.execute(rhombus, ShapeCommand::rotate(0, 30.0, 90.0, 40.0));
+    const std::vector<QPointF> before = rhombus.outline();
+
+    journal.execute(rhombus, ShapeCommand::setAcuteAngle(0, 45.0));
+    journal.undo([&rhombus](size_t) -> Shape& { return rhombus; });
+
+    const std::vector<QPointF> after = rhombus.outline();
+    QCOMPARE(after.size(), before.size());
+    for (size_t i = 0; i < before.size(); ++i) {
+        QVERIFY(qAbs(after[i].x() - before[i].x()) < 1e-9);
+        QVERIFY(qAbs(after[i].y() - before[i].y()) < 1e-9);
+    }
+}
+
+// Прямоугольник строит вершины из параметров при каждом повороте, поэтому
+// правку отдельной вершины он отклоняет, не меняя контура
+void GeometryTest::parametricVerticesRejectEdits() {
+    Rectangle rectangle(0.0, 0.0, 10.0, 6.0);
+    const std::vector<QPointF> before = rectangle.outline();
+
+    QVERIFY_EXCEPTION_THROWN(rectangle.setVertex(0, QPointF(-8.0, -5.0)), std::logic_error);
+    QVERIFY_EXCEPTION_THROWN(rectangle.addVertex(QPointF(1.0, 1.0)), std::logic_error);
+
+    rectangle.rotate(360.0, 0.0, 0.0);
+    const std::vector<QPointF> after = rectangle.outline();
+    QCOMPARE(after.size(), before.size());
+    for (size_t i = 0; i < before.size(); ++i) {
+        QVERIFY(qAbs(after[i].x() - before[i].x()) < 1e-9);
+        QVERIFY(qAbs(after[i].y() - before[i].y()) < 1e-9);
+    }
+}
+
+QTEST_APPLESS_MAIN(GeometryTest)
+
+#include "tst_geometry.moc"
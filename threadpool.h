@@ -0,0 +1,38 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Фиксированный набор рабочих потоков с общей очередью задач.
+// Задачи, не начатые к моменту уничтожения пула, отбрасываются.
+class ThreadPool {
+private:
+    std::vector<std::thread> workers;
+    std::deque<std::function<void()>> tasks;
+    std::mutex mutex;
+    std::condition_variable available;
+    bool stopping = false;
+
+    void workerLoop();
+
+public:
+    explicit ThreadPool(unsigned threadCount = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool &operator=(const ThreadPool&) = delete;
+
+    void submit(std::function<void()> task);
+
+    size_t threadCount() const { return workers.size(); }
+
+    // Общий пул на все ядра для фоновых геометрических задач
+    static ThreadPool &shared();
+};
+
+#endif // THREADPOOL_H
@@ -0,0 +1,99 @@
+#include "transform2d.h"
+#include "shape.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+void Transform2D::translate(double dx, double dy) {
+    tx += dx;
+    ty += dy;
+}
+
+void Transform2D::rotate(double angle, double originX, double originY) {
+    QPointF t = rotatePoint(QPointF(tx, ty), angle, originX, originY);
+    tx = t.x();
+    ty = t.y();
+
+    angleDeg = std::fmod(angleDeg + angle, 360.0);
+}
+
+void Transform2D::scale(double factor, double originX, double originY) {
+    if (factor <= 0.0) {
+        throw std::invalid_argument(
+            "Коэффициент масштабирования должен быть положительным. "
+            "Передано: " + std::to_string(factor)
+            );
+    }
+
+    tx = originX + (tx - originX) * factor;
+    ty = originY + (ty - originY) * factor;
+    scaleFactor *= factor;
+}
+
+Transform2D Transform2D::then(const Transform2D &next) const {
+    Transform2D result = *this;
+    result.rotate(next.angleDeg, 0.0, 0.0);
+    result.scale(next.scaleFactor, 0.0, 0.0);
+    result.translate(next.tx, next.ty);
+    return result;
+}
+
+Transform2D Transform2D::inverted() const {
+    Transform2D result(0.0, 1.0, -tx, -ty);
+    result.rotate(-angleDeg, 0.0, 0.0);
+    result.scale(1.0 / scaleFactor, 0.0, 0.0);
+    return result;
+}
+
+QPointF Transform2D::map(const QPointF &point) const {
+    double angleRad = angleDeg * M_PI / 180.0;
+    double a = scaleFactor * std::cos(angleRad);
+    double b = scaleFactor * std::sin(angleRad);
+
+    return QPointF(a * point.x() - b * point.y() + tx,
+                   b * point.x() + a * point.y() + ty);
+}
+
+void Transform2D::mapInPlace(std::vector<QPointF> &points) const {
+    if (isIdentity()) return;
+
+    double angleRad = angleDeg * M_PI / 180.0;
+    double a = scaleFactor * std::cos(angleRad);
+    double b = scaleFactor * std::sin(angleRad);
+
+    for (QPointF &p : points) {
+        double x = p.x();
+        double y = p.y();
+        p = QPointF(a * x - b * y + tx, b * x + a * y + ty);
+    }
+}
+
+std::vector<QPointF> Transform2D::mapped(const std::vector<QPointF> &points) const {
+    std::vector<QPointF> result(points);
+    mapInPlace(result);
+    return result;
+}
+
+QRectF Transform2D::mapBounds(const std::vector<QPointF> &points) const {
+    if (points.empty()) return QRectF();
+
+    double angleRad = angleDeg * M_PI / 180.0;
+    double a = scaleFactor * std::cos(angleRad);
+    double b = scaleFactor * std::sin(angleRad);
+
+    double minX = a * points[0].x() - b * points[0].y();
+    double maxX = minX;
+    double minY = b * points[0].x() + a * points[0].y();
+    double maxY = minY;
+
+    for (const QPointF &p : points) {
+        double x = a * p.x() - b * p.y();
+        double y = b * p.x() + a * p.y();
+        minX = std::min(minX, x);
+        maxX = std::max(maxX, x);
+        minY = std::min(minY, y);
+        maxY = std::max(maxY, y);
+    }
+
+    return QRectF(minX + tx, minY + ty, maxX - minX, maxY - minY);
+}
@@ -0,0 +1,49 @@
+#ifndef TRANSFORM2D_H
+#define TRANSFORM2D_H
+
+#include <QPointF>
+#include <QRectF>
+#include <vector>
+
+// Преобразование подобия p' = scale * R(angle) * p + (tx, ty).
+// Угол хранится отдельно от масштаба, поэтому многократные повороты
+// не искажают форму из-за накопления ошибок в матрице.
+class Transform2D {
+private:
+    double angleDeg;
+    double scaleFactor;
+    double tx;
+    double ty;
+
+public:
+    Transform2D() : angleDeg(0.0), scaleFactor(1.0), tx(0.0), ty(0.0) {}
+
+    Transform2D(double angle, double factor, double dx, double dy)
+        : angleDeg(angle), scaleFactor(factor), tx(dx), ty(dy) {}
+
+    bool isIdentity() const {
+        return angleDeg == 0.0 && scaleFactor == 1.0 && tx == 0.0 && ty == 0.0;
+    }
+
+    double angle() const { return angleDeg; }
+    double scale() const { return scaleFactor; }
+    double translationX() const { return tx; }
+    double translationY() const { return ty; }
+
+    void translate(double dx, double dy);
+    void rotate(double angle, double originX, double originY);
+    void scale(double factor, double originX, double originY);
+
+    // Сначала *this, затем next
+    Transform2D then(const Transform2D &next) const;
+    Transform2D inverted() const;
+
+    QPointF map(const QPointF &point) const;
+    void mapInPlace(std::vector<QPointF> &points) const;
+    std::vector<QPointF> mapped(const std::vector<QPointF> &points) const;
+
+    // Ограничивающий прямоугольник преобразованных точек без их копирования
+    QRectF mapBounds(const std::vector<QPointF> &points) const;
+};
+
+#endif // TRANSFORM2D_H
@@ -10,6 +10,8 @@ public:
 
     Triangle(double x, double y, double sideLength);
 
+    std::unique_ptr<Shape> clone() const override { return std::make_unique<Triangle>(*this); }
+
     double getSideA() const;
     double getSideB() const;
     double getSideC() const;
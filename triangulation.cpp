@@ -0,0 +1,93 @@
+#include "triangulation.h"
+#include <cmath>
+
+static double cross(const QPointF &a, const QPointF &b, const QPointF &c) {
+    return (b.x() - a.x()) * (c.y() - a.y()) - (b.y() - a.y()) * (c.x() - a.x());
+}
+
+static bool pointInTriangle(const QPointF &p, const QPointF &a, const QPointF &b, const QPointF &c) {
+    return cross(a, b, p) >= 0.0 && cross(b, c, p) >= 0.0 && cross(c, a, p) >= 0.0;
+}
+
+std::vector<uint32_t> triangulatePolygon(const std::vector<QPointF> &polygon) {
+    const size_t n = polygon.size();
+    std::vector<uint32_t> triangles;
+    if (n < 3) return triangles;
+    triangles.reserve(3 * (n - 2));
+
+    double signedArea = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        const QPointF &a = polygon[i];
+        const QPointF &b = polygon[(i + 1) % n];
+        signedArea += a.x() * b.y() - b.x() * a.y();
+    }
+
+    // Работаем в положительном обходе, индексы выдаём исходные
+    std::vector<uint32_t> ring(n);
+    for (size_t i = 0; i < n; ++i) {
+        ring[i] = static_cast<uint32_t>(signedArea >= 0.0 ? i : n - 1 - i);
+    }
+
+    auto addTriangle = [&](uint32_t a, uint32_t b, uint32_t c) {
+        if (signedArea >= 0.0) {
+            triangles.insert(triangles.end(), {a, b, c});
+        } else {
+            triangles.insert(triangles.end(), {c, b, a});
+        }
+    };
+
+    size_t guard = 0;
+    size_t i = 0;
+    while (ring.size() > 3) {
+        const size_t m = ring.size();
+        uint32_t ia = ring[(i + m - 1) % m];
+        uint32_t ib = ring[i % m];
+        uint32_t ic = ring[(i + 1) % m];
+        const QPointF &a = polygon[ia];
+        const QPointF &b = polygon[ib];
+        const QPointF &c = polygon[ic];
+
+        bool isEar = cross(a, b, c) > 0.0;
+        if (isEar) {
+            for (uint32_t k : ring) {
+                if (k == ia || k == ib || k == ic) continue;
+                if (pointInTriangle(polygon[k], a, b, c)) {
+                    isEar = false;
+                    break;
+                }
+            }
+        }
+
+        if (isEar) {
+            addTriangle(ia, ib, ic);
+            ring.erase(ring.begin() + static_cast<std::ptrdiff_t>(i % m));
+            guard = 0;
+            continue;
+        }
+
+        ++i;
+        // Вырожденный контур: ушей нет, добиваем веером
+        if (++guard > m) {
+            for (size_t k = 1; k + 1 < ring.size(); ++k) {
+                addTriangle(ring[0], ring[k], ring[k + 1]);
+            }
+            return triangles;
+        }
+    }
+
+    addTriangle(ring[0], ring[1], ring[2]);
+    return triangles;
+}
+
+std::vector<uint32_t> triangulateFan(uint32_t centerIndex, uint32_t first, uint32_t count) {
+    std::vector<uint32_t> triangles;
+    triangles.reserve(3 * count);
+
+    for (uint32_t i = 0; i < count; ++i) {
+        triangles.push_back(centerIndex);
+        triangles.push_back(first + i);
+        triangles.push_back(first + (i + 1) % count);
+    }
+
+    return triangles;
+}
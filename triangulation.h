@@ -0,0 +1,17 @@
+#ifndef TRIANGULATION_H
+#define TRIANGULATION_H
+
+#include <QPointF>
+#include <cstdint>
+#include <vector>
+
+// Триангуляция простого многоугольника отсечением ушей.
+// Возвращает тройки индексов вершин; обход треугольников совпадает
+// с обходом исходного многоугольника.
+std::vector<uint32_t> triangulatePolygon(const std::vector<QPointF> &polygon);
+
+// Веер из центральной вершины с индексом centerIndex к вершинам контура
+// [first, first + count): для выпуклых и звёздных относительно центра фигур.
+std::vector<uint32_t> triangulateFan(uint32_t centerIndex, uint32_t first, uint32_t count);
+
+#endif // TRIANGULATION_H